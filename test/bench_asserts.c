@@ -0,0 +1,97 @@
+/* ==========================================
+    Unity Project - A Test Framework for C
+    Copyright (c) 2007 Mike Karlesky, Mark VanderVoord, Greg Williams
+    [Released under MIT License. Please refer to license.txt for details]
+========================================== */
+
+// Times the number, bits and delta assertions, which are checked inline
+// unless UNITY_EXCLUDE_INLINE_ASSERTS is defined.  Build it both ways and
+// give the inline run the other's report as its baseline to compare them
+// (add -DUNITY_USE_LIMITS_H where the compiler needs it to size its types):
+//
+//     cc -O2 -DUNITY_SUPPORT_TIMING -DUNITY_EXCLUDE_INLINE_ASSERTS -I. test/bench_asserts.c unity.c -o bench_calls
+//     cc -O2 -DUNITY_SUPPORT_TIMING -I. test/bench_asserts.c unity.c -o bench_inline
+//     ./bench_calls && mv bench_asserts.c.json calls.json
+//     UNITY_BASELINE=calls.json ./bench_inline
+//
+// Each benchmark makes REPEAT passing assertions a call.
+
+#include "unity.h"
+
+void setUp(void) {}
+void tearDown(void) {}
+
+#define REPEAT (1000)
+
+static _U_SINT Expected[REPEAT];
+static _U_SINT Actual[REPEAT];
+
+static void benchEqualInt(void)
+{
+    int i;
+
+    for (i = 0; i < REPEAT; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(Expected[i], Actual[i]);
+    }
+}
+
+static void benchEqualHex8(void)
+{
+    int i;
+
+    for (i = 0; i < REPEAT; i++)
+    {
+        TEST_ASSERT_EQUAL_HEX8(Expected[i], Actual[i]);
+    }
+}
+
+static void benchBits(void)
+{
+    int i;
+
+    for (i = 0; i < REPEAT; i++)
+    {
+        TEST_ASSERT_BITS(0xFF00FF, Expected[i], Actual[i] ^ 0xFF00);
+    }
+}
+
+static void benchIntWithin(void)
+{
+    int i;
+
+    for (i = 0; i < REPEAT; i++)
+    {
+        TEST_ASSERT_INT_WITHIN(3, Expected[i], Actual[i] - 2);
+    }
+}
+
+static void benchUintWithin(void)
+{
+    int i;
+
+    for (i = 0; i < REPEAT; i++)
+    {
+        TEST_ASSERT_UINT_WITHIN(3, Expected[i], Actual[i] + 3);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int i;
+
+    for (i = 0; i < REPEAT; i++)
+    {
+        Expected[i] = Actual[i] = (_U_SINT)(i * 2654435761u) & 0x7FFFFF;
+    }
+
+    Unity.TestFile = "bench_asserts.c";
+    UnityParseOptions(argc, argv);
+    UnityBegin();
+    RUN_BENCHMARK(benchEqualInt, 29);
+    RUN_BENCHMARK(benchEqualHex8, 39);
+    RUN_BENCHMARK(benchBits, 49);
+    RUN_BENCHMARK(benchIntWithin, 59);
+    RUN_BENCHMARK(benchUintWithin, 69);
+    return UnityEnd();
+}
@@ -0,0 +1,296 @@
+#!/bin/sh
+# Unity's self-tests.  Each one checks a fast path of Unity's against a plain
+# version of the same thing, or a run that reorders, splits, logs or replays
+# tests against one that does not, and the whole set is built twice: with the
+# SIMD kernels and with UNITY_EXCLUDE_SIMD.  Run it from anywhere:
+#
+#     CC=gcc test/selftest.sh [extra cflags]
+#
+# The exit status is the number of checks that failed.
+
+here=$(cd "$(dirname "$0")" && pwd)
+root=$(dirname "$here")
+CC=${CC:-cc}
+CFLAGS="-std=gnu99 -Wall -Wextra -DUNITY_USE_LIMITS_H $*"
+work=$(mktemp -d) || exit 255
+trap 'rm -rf "$work"' EXIT
+trap 'exit 255' INT TERM
+failures=0
+
+# pass CHECK / fail CHECK: report how a check went
+pass()
+{
+    echo "PASS $label $1"
+}
+
+fail()
+{
+    echo "FAIL $label $1"
+    failures=$((failures + 1))
+}
+
+# build DIR NAME SOURCE... [CFLAGS...]: compile the sources with unity.c into DIR/NAME
+build()
+{
+    into=$1
+    program=$2
+    shift 2
+    mkdir -p "$into" && $CC $CFLAGS $variant -I"$root" -o "$into/$program" "$@" "$root/unity.c"
+}
+
+# run_test NAME [CFLAGS...]: build test/NAME.c and run it in a directory of its own
+run_test()
+{
+    name=$1
+    shift
+    check=$(echo "$name $*" | sed 's/ *$//')
+    dir="$work/$label/$(echo "$check" | tr -c 'A-Za-z0-9_\n' _)"
+    if ! build "$dir" "$name" "$here/$name.c" "$@"; then
+        fail "$check (build)"
+    elif (cd "$dir" && "./$name") > "$dir/output.txt" 2>&1; then
+        pass "$check"
+    else
+        cat "$dir/output.txt"
+        fail "$check"
+    fi
+}
+
+# same DIR1 DIR2 FILE...: the files must be alike in both directories; show how they differ if not
+same()
+{
+    left=$1
+    right=$2
+    shift 2
+    for file in "$@"
+    do
+        if ! cmp -s "$left/$file" "$right/$file"; then
+            diff -u "$left/$file" "$right/$file" | head -40
+            return 1
+        fi
+    done
+}
+
+# check_decode: a binary log read back by unity_decode must give the console output,
+# JSON report, JUnit XML and exit status of the same tests built to write them
+check_decode()
+{
+    dir="$work/$label/decode"
+    if ! build "$dir/text" test_report "$here/test_report.c" -DUNITY_REPORT_JUNIT ||
+       ! build "$dir/log" test_report "$here/test_report.c" -DUNITY_REPORT_BINARY ||
+       ! build "$dir" unity_decode "$root/unity_decode.c"; then
+        fail "unity_decode (build)"
+        return
+    fi
+    (cd "$dir/text" && ./test_report > console.txt)
+    status_text=$?
+    (cd "$dir/log" && ./test_report > /dev/null; ../unity_decode --console test_report.c.ulog > console.txt)
+    status_log=$?
+    (cd "$dir/log" && ../unity_decode --json test_report.c.ulog; ../unity_decode --junit test_report.c.ulog) > /dev/null
+
+    if [ $status_text -eq $status_log ] &&
+       same "$dir/text" "$dir/log" console.txt test_report.c.json test_report.c.xml; then
+        pass "unity_decode"
+    else
+        fail "unity_decode"
+    fi
+}
+
+# check_select: the tests run must be the ones a plain matcher picks, for each set of
+# patterns below (one a line, split at spaces; none on the first)
+check_select()
+{
+    dir="$work/$label/select"
+    if ! build "$dir" test_select "$here/test_select.c"; then
+        fail "test_select (build)"
+        return
+    fi
+    set -f
+    while read -r patterns
+    do
+        check=$(echo "test_select $patterns" | sed 's/ *$//')
+        # its own two tests must have run, whatever else the patterns left out
+        if (cd "$dir" && ./test_select $patterns) > "$dir/output.txt" 2>&1 &&
+           grep -q '^2 Tests 0 Failures' "$dir/output.txt"; then
+            pass "$check"
+        else
+            cat "$dir/output.txt"
+            fail "$check"
+        fi
+    done <<EOF
+
+--include=testA0,testB7919,testZ1
+--include=testC*
+--include=test?1*
+--include testD* --include=*9?
+--include=testE*,,testB7919,testF1??9*,testH1084903**
+--include=,
+--exclude=testA*,*7
+--include=testA*,testB*,*5 --exclude=*3*,testB7919
+--include=*1*2*3* --exclude=*4??
+--include=test*4*4 --exclude testG*
+EOF
+    set +f
+}
+
+# check_history: with a history, a run must start with the tests that failed last
+# time and then keep table order, and still report its results in table order
+check_history()
+{
+    for runner in fork threads
+    do
+        dir="$work/$label/history/$runner"
+        if [ $runner = fork ]; then runner_flags=-DUNITY_SUPPORT_FORK; else runner_flags="-DUNITY_SUPPORT_THREADS -pthread"; fi
+        if ! build "$dir" test_history "$here/test_history.c" $runner_flags; then
+            fail "history $runner (build)"
+            continue
+        fi
+        # the order each run must go in, then the test it fails
+        mkdir -p "$dir/table" "$dir/1/expected" "$dir/2/expected" "$dir/3/expected" "$dir/4/expected"
+        printf 'test%s\n' A B C D E F G H > "$dir/table/results.txt"
+        printf 'test%s\n' A B C D E F G H > "$dir/1/expected/order.txt"
+        printf 'test%s\n' F A B C D E G H > "$dir/2/expected/order.txt"
+        printf 'test%s\n' F A B C D E G H > "$dir/3/expected/order.txt"
+        printf 'test%s\n' C A B D E F G H > "$dir/4/expected/order.txt"
+        ok=1
+        for run in 1 2 3 4
+        do
+            case $run in 1|2) failing=testF;; 3) failing=testC;; *) failing=none;; esac
+            (cd "$dir/$run" && ../test_history --history ../history.txt --fail $failing > console.txt)
+            grep '^test_history\.c:' "$dir/$run/console.txt" | cut -d: -f3 > "$dir/$run/results.txt"
+            same "$dir/$run/expected" "$dir/$run" order.txt || ok=0
+            same "$dir/table" "$dir/$run" results.txt || ok=0
+        done
+        # the same failure in the same table is reported alike, whichever order it ran in
+        same "$dir/1" "$dir/2" console.txt || ok=0
+        if [ $ok -eq 1 ]; then pass "history $runner"; else fail "history $runner"; fi
+    done
+}
+
+# cache_run N [VAR=VALUE]: run test_cache in directory N against the shared cache,
+# with the environment given; its exit status goes to N/status.txt
+cache_run()
+{
+    mkdir -p "$dir/$1"
+    (cd "$dir/$1" && env $2 ../test_cache --cache ../cache --cache-inputs ../input.txt > console.txt; echo $? > status.txt)
+}
+
+# check_cache: a run played back from the cache must report what the run it was
+# recorded from did and run no tests, and a changed timeout or input must miss
+check_cache()
+{
+    dir="$work/$label/cache"
+    if ! build "$dir" test_cache "$here/test_cache.c" -DUNITY_SUPPORT_CACHE -DUNITY_SUPPORT_TIMEOUTS; then
+        fail "cache (build)"
+        return
+    fi
+    echo good > "$dir/input.txt"
+    cache_run 1
+    cache_run 2
+    cache_run 3 UNITY_TEST_TIMEOUT_MS=60000
+    cache_run 4 UNITY_TEST_TIMEOUT_MS=60000
+    echo bad > "$dir/input.txt"
+    cache_run 5
+    cache_run 6
+
+    ok=1
+    # misses run every test; hits run none
+    for run in 1 3 5
+    do
+        [ -s "$dir/$run/ran.txt" ] || ok=0
+    done
+    for run in 2 4 6
+    do
+        [ ! -e "$dir/$run/ran.txt" ] || ok=0
+    done
+    same "$dir/1" "$dir/2" console.txt test_cache.c.json status.txt || ok=0
+    same "$dir/1" "$dir/3" console.txt test_cache.c.json status.txt || ok=0
+    same "$dir/3" "$dir/4" console.txt test_cache.c.json status.txt || ok=0
+    same "$dir/5" "$dir/6" console.txt test_cache.c.json status.txt || ok=0
+    # the changed input was really run: testInput fails as well now
+    [ "$(cat "$dir/1/status.txt")" = 1 ] && [ "$(cat "$dir/5/status.txt")" = 2 ] || ok=0
+    if [ $ok -eq 1 ]; then pass "cache"; else fail "cache"; fi
+}
+
+# check_inline: the assertions Unity checks inline must report exactly what the
+# same assertions report when every one is a call into unity.c
+check_inline()
+{
+    dir="$work/$label/inline"
+    if ! build "$dir/inline" test_inline "$here/test_inline.c" -DUNITY_SUPPORT_64 ||
+       ! build "$dir/calls" test_inline "$here/test_inline.c" -DUNITY_SUPPORT_64 -DUNITY_EXCLUDE_INLINE_ASSERTS; then
+        fail "inline asserts (build)"
+        return
+    fi
+    (cd "$dir/inline" && ./test_inline > console.txt)
+    status_inline=$?
+    (cd "$dir/calls" && ./test_inline > console.txt)
+    status_calls=$?
+
+    if [ $status_inline -eq $status_calls ] &&
+       same "$dir/calls" "$dir/inline" console.txt test_inline.c.json; then
+        pass "inline asserts"
+    else
+        fail "inline asserts"
+    fi
+
+    # the benchmark only has to build here; see its header for running it
+    if build "$dir" bench_asserts "$here/bench_asserts.c" -DUNITY_SUPPORT_TIMING; then
+        pass "bench_asserts (build)"
+    else
+        fail "bench_asserts (build)"
+    fi
+}
+
+# check_shards: the shards of a run must report between them every result of the
+# unsharded run once, and unity_merge must add up their console outputs and JSON
+# reports to its summary and exit status
+check_shards()
+{
+    dir="$work/$label/shards"
+    if ! build "$dir" test_report "$here/test_report.c" || ! build "$dir" unity_merge "$root/unity_merge.c"; then
+        fail "unity_merge (build)"
+        return
+    fi
+    mkdir -p "$dir/all" "$dir/console" "$dir/json"
+    (cd "$dir/all" && ../test_report > console.txt)
+    status_all=$?
+    grep '^test_report\.c:' "$dir/all/console.txt" | sort > "$dir/all/results.txt"
+    tail -n 3 "$dir/all/console.txt" > "$dir/all/summary.txt"
+
+    for i in 0 1 2
+    do
+        mkdir -p "$dir/$i"
+        (cd "$dir/$i" && ../test_report --shard $i/3 > console.txt)
+    done
+    grep -h '^test_report\.c:' "$dir"/[012]/console.txt | sort > "$dir/console/results.txt"
+    "$dir/unity_merge" "$dir"/[012]/console.txt > "$dir/console/summary.txt"
+    status_console=$?
+    "$dir/unity_merge" "$dir"/[012]/test_report.c.json > "$dir/json/summary.txt"
+    status_json=$?
+
+    if [ $status_all -eq $status_console ] && [ $status_all -eq $status_json ] &&
+       same "$dir/all" "$dir/console" results.txt summary.txt &&
+       same "$dir/all" "$dir/json" summary.txt; then
+        pass "shards and unity_merge"
+    else
+        fail "shards and unity_merge"
+    fi
+}
+
+for variant in "" "-DUNITY_EXCLUDE_SIMD"
+do
+    if [ -z "$variant" ]; then label=simd; else label=scalar; fi
+
+    run_test test_kernels -DUNITY_SUPPORT_64 -DUNITY_INCLUDE_DOUBLE
+    run_test test_format
+    run_test test_format -DUNITY_SUPPORT_64
+    check_select
+    check_inline
+    check_history
+    check_cache
+    check_decode
+    check_shards
+done
+
+echo "$failures failed"
+exit $failures
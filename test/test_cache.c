@@ -0,0 +1,77 @@
+/* ==========================================
+    Unity Project - A Test Framework for C
+    Copyright (c) 2007 Mike Karlesky, Mark VanderVoord, Greg Williams
+    [Released under MIT License. Please refer to license.txt for details]
+========================================== */
+
+// A suite for selftest.sh to run again and again with --cache.  Each test
+// appends its name to ran.txt as it runs, so a run played back from the cache
+// leaves none behind, and testInput checks the file named by --cache-inputs,
+// so a changed input must be run to be reported right.
+
+#include "unity.h"
+#include <stdio.h>
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static const char* Input = "input.txt";
+
+//-----------------------------------------------
+static void Ran(const char* name)
+{
+    FILE* ran = fopen("ran.txt", "a");
+
+    if (ran != NULL)
+    {
+        fprintf(ran, "%s\n", name);
+        fclose(ran);
+    }
+}
+
+void testPasses(void)
+{
+    Ran("testPasses");
+    TEST_ASSERT_EQUAL_INT(42, 42);
+}
+
+void testFails(void)
+{
+    Ran("testFails");
+    TEST_ASSERT_EQUAL_INT_MESSAGE(1, 2, "failed on purpose");
+}
+
+void testIgnored(void)
+{
+    Ran("testIgnored");
+    TEST_IGNORE_MESSAGE("not this time");
+}
+
+void testInput(void)
+{
+    char text[64] = "";
+    FILE* input = fopen(Input, "r");
+
+    Ran("testInput");
+    TEST_ASSERT_NOT_NULL(input);
+    if (fgets(text, sizeof(text), input) == NULL)
+        text[0] = '\0';
+    fclose(input);
+    TEST_ASSERT_EQUAL_STRING("good\n", text);
+}
+
+//-----------------------------------------------
+int main(int argc, char* argv[])
+{
+    Unity.TestFile = "test_cache.c";
+    UnityParseOptions(argc, argv);
+    if (Unity.CacheInputs != NULL)
+        Input = Unity.CacheInputs;
+    UnityBegin();
+    RUN_TEST(testPasses, 33);
+    RUN_TEST(testFails, 39);
+    RUN_TEST(testIgnored, 45);
+    RUN_TEST(testInput, 51);
+    return UnityEnd();
+}
@@ -0,0 +1,262 @@
+/* ==========================================
+    Unity Project - A Test Framework for C
+    Copyright (c) 2007 Mike Karlesky, Mark VanderVoord, Greg Williams
+    [Released under MIT License. Please refer to license.txt for details]
+========================================== */
+
+// Checks the number formatters, which write two digits per division and
+// index tables for hex digits and masks, against sprintf and a bit loop.
+// Every value next to a power of ten or two is tried along with random values
+// of every length, and then reported through a sink, to check the text the
+// sinks are given as well.
+
+#include "unity.h"
+#include <stdio.h>
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+#define TRIALS (100000)
+
+static const UNITY_DISPLAY_STYLE_T Styles[] =
+{
+    UNITY_DISPLAY_STYLE_INT,  UNITY_DISPLAY_STYLE_INT8,  UNITY_DISPLAY_STYLE_INT16,  UNITY_DISPLAY_STYLE_INT32,
+    UNITY_DISPLAY_STYLE_UINT, UNITY_DISPLAY_STYLE_UINT8, UNITY_DISPLAY_STYLE_UINT16, UNITY_DISPLAY_STYLE_UINT32,
+    UNITY_DISPLAY_STYLE_HEX8, UNITY_DISPLAY_STYLE_HEX16, UNITY_DISPLAY_STYLE_HEX32,
+#ifdef UNITY_SUPPORT_64
+    UNITY_DISPLAY_STYLE_INT64, UNITY_DISPLAY_STYLE_UINT64, UNITY_DISPLAY_STYLE_HEX64,
+#endif
+};
+#define STYLE_COUNT ((_UU32)(sizeof(Styles) / sizeof(Styles[0])))
+
+static char Case[64];
+
+//-----------------------------------------------
+// Helpers
+//-----------------------------------------------
+
+/// the same sequence on every run, so a failure can be repeated
+static _UU32 Random(void)
+{
+    static _UU32 state = 2463534242u;
+
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+//-----------------------------------------------
+/// a random number of random length, so short numbers come up as often as long ones
+static _U_UINT RandomNumber(void)
+{
+    _U_UINT number = 0;
+    size_t i;
+
+    for (i = 0; i < sizeof(_U_UINT); i += 4)
+    {
+        number = (number << 16 << 16) | Random();
+    }
+    return number >> (Random() % (8 * sizeof(_U_UINT)));
+}
+
+//-----------------------------------------------
+/// the number as sprintf writes it in the style
+static void ReferenceByStyle(char* buffer, const _U_SINT number, const UNITY_DISPLAY_STYLE_T style)
+{
+    const _UU32 bytes = (_UU32)style & 0x0F;
+    const _U_UINT mask = (bytes >= sizeof(_U_UINT)) ? ~(_U_UINT)0 : (((_U_UINT)1 << (8 * bytes)) - 1);
+
+    if ((style & UNITY_DISPLAY_RANGE_INT) == UNITY_DISPLAY_RANGE_INT)
+        sprintf(buffer, "%lld", (long long)number);
+    else if ((style & UNITY_DISPLAY_RANGE_UINT) == UNITY_DISPLAY_RANGE_UINT)
+        sprintf(buffer, "%llu", (unsigned long long)((_U_UINT)number & mask));
+    else
+        sprintf(buffer, "0x%0*llX", (int)(2 * bytes), (unsigned long long)((_U_UINT)number & mask));
+}
+
+//-----------------------------------------------
+/// the mask as a plain loop writes it: the number's bit where the mask is set, X where it is not
+static void ReferenceMask(char* buffer, const _U_UINT mask, const _U_UINT number)
+{
+    int bit;
+
+    for (bit = UNITY_INT_WIDTH - 1; bit >= 0; bit--)
+    {
+        *buffer++ = ((mask >> bit) & 1) ? (char)('0' + ((number >> bit) & 1)) : 'X';
+    }
+    *buffer = '\0';
+}
+
+//-----------------------------------------------
+/// check every formatter on one number
+static void CheckNumber(const _U_UINT number)
+{
+    char expected[UNITY_FIELD_TEXT_SIZE];
+    char actual[UNITY_FIELD_TEXT_SIZE];
+    _U_UINT bits;
+    _UU32 i, length;
+
+    sprintf(Case, "number 0x%llX", (unsigned long long)number);
+
+    sprintf(expected, "%llu", (unsigned long long)number);
+    length = UnityFormatNumberUnsigned(actual, number);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, actual, Case);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(strlen(expected), length, Case);
+
+    sprintf(expected, "%lld", (long long)(_U_SINT)number);
+    length = UnityFormatNumber(actual, (_U_SINT)number);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, actual, Case);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(strlen(expected), length, Case);
+
+    for (i = 0; i < STYLE_COUNT; i++)
+    {
+        ReferenceByStyle(expected, (_U_SINT)number, Styles[i]);
+        length = UnityFormatNumberByStyle(actual, (_U_SINT)number, Styles[i]);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, actual, Case);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(strlen(expected), length, Case);
+    }
+
+    bits = RandomNumber();
+    ReferenceMask(expected, number, bits);
+    length = UnityFormatMask(actual, number, bits);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, actual, Case);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(strlen(expected), length, Case);
+}
+
+//-----------------------------------------------
+// Sink
+//-----------------------------------------------
+
+static char Captured[UNITY_RESULT_MAX_FIELDS][UNITY_FIELD_TEXT_SIZE];
+static _UU32 CapturedCount;
+
+static void CaptureBegin(const struct _UnityResult* result)
+{
+    (void)result;
+    CapturedCount = 0;
+}
+
+static void CaptureField(const struct _UnityField* field, const char* text)
+{
+    (void)field;
+    if (CapturedCount < UNITY_RESULT_MAX_FIELDS)
+    {
+        strcpy(Captured[CapturedCount++], text);
+    }
+}
+
+static const struct _UnitySink CaptureSink = { CaptureBegin, CaptureField, NULL, 0 };
+
+//-----------------------------------------------
+/// report a result with the number in a field of every style, and a mask, and check what a sink is given
+static void CheckReported(const _U_UINT number)
+{
+    struct _UnityField fields[UNITY_RESULT_MAX_FIELDS];
+    struct _UnityResult result;
+    char expected[UNITY_FIELD_TEXT_SIZE];
+    _UU32 i, count = 0;
+
+    memset(fields, 0, sizeof(fields));
+    memset(&result, 0, sizeof(result));
+    for (i = 0; (i < STYLE_COUNT) && (count < UNITY_RESULT_MAX_FIELDS - 1); i++, count++)
+    {
+        fields[count].Kind = UNITY_FIELD_EXPECTED;
+        fields[count].Type = UNITY_VALUE_NUMBER;
+        fields[count].Style = Styles[i];
+        fields[count].Number = (_U_SINT)number;
+    }
+    fields[count].Kind = UNITY_FIELD_ACTUAL;
+    fields[count].Type = UNITY_VALUE_MASK;
+    fields[count].Mask = (_U_SINT)~number;
+    fields[count].Number = (_U_SINT)number;
+    count++;
+
+    result.File = Unity.TestFile;
+    result.TestName = Unity.CurrentTestName;
+    result.Status = UNITY_RESULT_FAIL;
+    result.FieldCount = count;
+    result.Fields = fields;
+
+    UnityClearSinks();
+    UnityAddSink(&CaptureSink);
+    UnityReportResult(&result);
+    UnityClearSinks();
+    UnityAddSink(&UnitySinkConsole);
+
+    sprintf(Case, "reported 0x%llX", (unsigned long long)number);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(count, CapturedCount, Case);
+    for (i = 0; i + 1 < count; i++)
+    {
+        ReferenceByStyle(expected, (_U_SINT)number, fields[i].Style);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, Captured[i], Case);
+    }
+    ReferenceMask(expected, ~number, number);
+    TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, Captured[count - 1], Case);
+}
+
+//-----------------------------------------------
+// Tests
+//-----------------------------------------------
+
+void testNumbersNextToPowersOfTenAndTwo(void)
+{
+    _U_UINT power;
+    int bit;
+
+    // every length, from either side of where a digit is added
+    for (power = 1; ; power *= 10)
+    {
+        CheckNumber(power - 1);
+        CheckNumber(power);
+        CheckNumber(power + 1);
+        CheckNumber((_U_UINT)0 - power);
+        if (power > ~(_U_UINT)0 / 10)
+            break;
+    }
+    for (bit = 0; bit < (int)(8 * sizeof(_U_UINT)); bit++)
+    {
+        power = (_U_UINT)1 << bit;
+        CheckNumber(power - 1);
+        CheckNumber(power);
+        CheckNumber(power | (power >> 1));
+    }
+    CheckNumber(~(_U_UINT)0);
+}
+
+//-----------------------------------------------
+void testRandomNumbers(void)
+{
+    _UU32 trial;
+
+    for (trial = 0; trial < TRIALS; trial++)
+    {
+        CheckNumber(RandomNumber());
+    }
+}
+
+//-----------------------------------------------
+void testReportedFields(void)
+{
+    _UU32 trial;
+
+    CheckReported(0);
+    CheckReported(~(_U_UINT)0);
+    for (trial = 0; trial < TRIALS / 10; trial++)
+    {
+        CheckReported(RandomNumber());
+    }
+}
+
+//-----------------------------------------------
+int main(void)
+{
+    Unity.TestFile = "test_format.c";
+    UnityAddSink(&UnitySinkConsole);
+    UnityBegin();
+    RUN_TEST(testNumbersNextToPowersOfTenAndTwo, 203);
+    RUN_TEST(testRandomNumbers, 229);
+    RUN_TEST(testReportedFields, 240);
+    return UnityEnd();
+}
@@ -0,0 +1,77 @@
+/* ==========================================
+    Unity Project - A Test Framework for C
+    Copyright (c) 2007 Mike Karlesky, Mark VanderVoord, Greg Williams
+    [Released under MIT License. Please refer to license.txt for details]
+========================================== */
+
+// A table of tests run on one worker, forked with UNITY_SUPPORT_FORK and on a
+// thread otherwise, for selftest.sh to run again and again with --history.
+// Each test appends its name to order.txt as it runs, and the one named by
+// --fail fails, so the order a history gives can be checked against the
+// results, which must still be reported in table order.
+
+#include "unity.h"
+#include <stdio.h>
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static const char* Failing = "";
+
+//-----------------------------------------------
+static void Run(const char* name)
+{
+    FILE* order = fopen("order.txt", "a");
+
+    if (order != NULL)
+    {
+        fprintf(order, "%s\n", name);
+        fclose(order);
+    }
+    if (strcmp(name, Failing) == 0)
+        TEST_FAIL_MESSAGE("failed on purpose");
+}
+
+void testA(void) { Run("testA"); }
+void testB(void) { Run("testB"); }
+void testC(void) { Run("testC"); }
+void testD(void) { Run("testD"); }
+void testE(void) { Run("testE"); }
+void testF(void) { Run("testF"); }
+void testG(void) { Run("testG"); }
+void testH(void) { Run("testH"); }
+
+static const UnityTestEntry Tests[] =
+{
+    UNITY_TEST_ENTRY(testA, 36),
+    UNITY_TEST_ENTRY(testB, 37),
+    UNITY_TEST_ENTRY(testC, 38),
+    UNITY_TEST_ENTRY(testD, 39),
+    UNITY_TEST_ENTRY(testE, 40),
+    UNITY_TEST_ENTRY(testF, 41),
+    UNITY_TEST_ENTRY(testG, 42),
+    UNITY_TEST_ENTRY(testH, 43),
+};
+
+//-----------------------------------------------
+int main(int argc, char* argv[])
+{
+    int i;
+
+    for (i = 1; i + 1 < argc; i++)
+    {
+        if (strcmp(argv[i], "--fail") == 0)
+            Failing = argv[i + 1];
+    }
+
+    Unity.TestFile = "test_history.c";
+    UnityParseOptions(argc, argv);
+    UnityBegin();
+#ifdef UNITY_SUPPORT_FORK
+    RUN_TESTS_FORKED(Tests, 1);
+#else
+    RUN_TESTS_PARALLEL(Tests, 1);
+#endif
+    return UnityEnd();
+}
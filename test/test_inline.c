@@ -0,0 +1,110 @@
+/* ==========================================
+    Unity Project - A Test Framework for C
+    Copyright (c) 2007 Mike Karlesky, Mark VanderVoord, Greg Williams
+    [Released under MIT License. Please refer to license.txt for details]
+========================================== */
+
+// Runs the number, bits and delta assertions, which are checked inline
+// unless UNITY_EXCLUDE_INLINE_ASSERTS is defined, over values at the edges
+// of every width and around every delta.  Each case is reported as a test
+// of its own; selftest.sh builds it both ways and the two runs must report
+// the same, byte for byte.
+
+#include "unity.h"
+#include <stdio.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+#define CASES (4000)
+
+static const _U_SINT Edges[] =
+{
+    0, 1, 2, 3, 126, 127, 128, 129, 254, 255, 256,
+    32766, 32767, 32768, 65534, 65535, 65536,
+    2147483646, 2147483647, -1, -2, -3, -127, -128, -129, -32768, -32769, -2147483647 - 1
+};
+#define EDGE_COUNT (sizeof(Edges) / sizeof(Edges[0]))
+
+static _U_SINT Delta;
+static _U_SINT Expected;
+static _U_SINT Actual;
+static _UU32 Kind;
+static char Name[32];
+
+//-----------------------------------------------
+/// the same sequence on every run, so both builds see the same cases
+static _UU32 Random(void)
+{
+    static _UU32 state = 2463534242u;
+
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+//-----------------------------------------------
+static _U_SINT RandomValue(void)
+{
+    return (Random() & 1) ? Edges[Random() % EDGE_COUNT] : (_U_SINT)(_US32)Random();
+}
+
+//-----------------------------------------------
+static void testCase(void)
+{
+    switch (Kind)
+    {
+        case 0:  TEST_ASSERT_EQUAL_INT(Expected, Actual); break;
+        case 1:  TEST_ASSERT_EQUAL_INT8(Expected, Actual); break;
+        case 2:  TEST_ASSERT_EQUAL_INT16(Expected, Actual); break;
+        case 3:  TEST_ASSERT_EQUAL_INT32(Expected, Actual); break;
+        case 4:  TEST_ASSERT_EQUAL_UINT(Expected, Actual); break;
+        case 5:  TEST_ASSERT_EQUAL_UINT8(Expected, Actual); break;
+        case 6:  TEST_ASSERT_EQUAL_UINT16(Expected, Actual); break;
+        case 7:  TEST_ASSERT_EQUAL_UINT32(Expected, Actual); break;
+        case 8:  TEST_ASSERT_EQUAL_HEX8(Expected, Actual); break;
+        case 9:  TEST_ASSERT_EQUAL_HEX16(Expected, Actual); break;
+        case 10: TEST_ASSERT_EQUAL_HEX32_MESSAGE(Expected, Actual, "hex32"); break;
+        case 11: TEST_ASSERT_BITS(Delta, Expected, Actual); break;
+        case 12: TEST_ASSERT_BITS_HIGH(Delta, Actual); break;
+        case 13: TEST_ASSERT_BITS_LOW(Delta, Actual); break;
+        case 14: TEST_ASSERT_INT_WITHIN(Delta, Expected, Actual); break;
+        case 15: TEST_ASSERT_UINT_WITHIN(Delta, Expected, Actual); break;
+        case 16: TEST_ASSERT_HEX8_WITHIN(Delta, Expected, Actual); break;
+        case 17: TEST_ASSERT_HEX16_WITHIN(Delta, Expected, Actual); break;
+        case 18: TEST_ASSERT_HEX32_WITHIN(Delta, Expected, Actual); break;
+        case 19: TEST_ASSERT_EQUAL_PTR((void*)(_UP)Expected, (void*)(_UP)Actual); break;
+#ifdef UNITY_SUPPORT_64
+        case 20: TEST_ASSERT_EQUAL_INT64(Expected * 4294967296LL, Actual * 4294967296LL); break;
+        case 21: TEST_ASSERT_EQUAL_HEX64(Expected, Actual); break;
+        case 22: TEST_ASSERT_HEX64_WITHIN(Delta, Expected, Actual); break;
+#endif
+        default: TEST_ASSERT_EQUAL(Expected, Actual); break;
+    }
+}
+
+//-----------------------------------------------
+int main(void)
+{
+    _UU32 i;
+
+    Unity.TestFile = "test_inline.c";
+    UnityBegin();
+    for (i = 0; i < CASES; i++)
+    {
+        Kind = Random() % 24;
+        Expected = RandomValue();
+        // equal half the time, else mostly near expected, where deltas and widths decide
+        switch (Random() % 4)
+        {
+            case 0:  Actual = RandomValue(); break;
+            case 1:  Actual = (_U_SINT)((_U_UINT)Expected + Random() % 9 - 4); break;
+            default: Actual = Expected; break;
+        }
+        Delta = (Random() % 4) ? (_U_SINT)(Random() % 6) : RandomValue();
+        sprintf(Name, "testCase%u", (unsigned)i);
+        UnityDefaultTestRun(testCase, Name, (int)(Kind + 1));
+    }
+    return UnityEnd();
+}
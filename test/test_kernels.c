@@ -0,0 +1,584 @@
+/* ==========================================
+    Unity Project - A Test Framework for C
+    Copyright (c) 2007 Mike Karlesky, Mark VanderVoord, Greg Williams
+    [Released under MIT License. Please refer to license.txt for details]
+========================================== */
+
+// Checks the comparison kernels (SSE2/AVX2, or the word loops with
+// UNITY_EXCLUDE_SIMD) against plain loops written out here: every failure
+// must name the element, byte and values the loop finds first.  Random
+// sizes and offsets walk the kernels through their unaligned heads and tails.
+// selftest.sh builds it with and without UNITY_EXCLUDE_SIMD.
+
+#include "unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+#define TRIALS      (4000)
+#define BUFFER_SIZE (1200)
+
+static unsigned char ExpectedBytes[BUFFER_SIZE + 64];
+static unsigned char ActualBytes[BUFFER_SIZE + 64];
+static char Case[128];
+
+//-----------------------------------------------
+// Helpers
+//-----------------------------------------------
+
+/// run an assertion that should fail, setting failed if it did; the failure's fields are left in Unity.CurrentFields
+#define EXPECT_FAILURE(failed, assertion)                           \
+    do                                                              \
+    {                                                               \
+        jmp_buf outer_frame;                                        \
+        memcpy(outer_frame, Unity.AbortFrame, sizeof(jmp_buf));     \
+        (failed) = 0;                                               \
+        if (TEST_PROTECT())                                         \
+        {                                                           \
+            assertion;                                              \
+        }                                                           \
+        else                                                        \
+        {                                                           \
+            (failed) = 1;                                           \
+        }                                                           \
+        memcpy(Unity.AbortFrame, outer_frame, sizeof(jmp_buf));     \
+        Unity.CurrentTestFailed = 0;                                \
+    } while (0)
+
+//-----------------------------------------------
+/// the same sequence on every run, so a failure can be repeated
+static _UU32 Random(void)
+{
+    static _UU32 state = 2463534242u;
+
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+//-----------------------------------------------
+/// the value of the first field of this kind in the failure just caught, or -1 if it has none
+static _U_SINT FailureNumber(const UNITY_FIELD_T kind)
+{
+    _UU32 i;
+
+    for (i = 0; i < Unity.CurrentResult.FieldCount; i++)
+    {
+        if (Unity.CurrentFields[i].Kind == kind)
+            return Unity.CurrentFields[i].Number;
+    }
+    return -1;
+}
+
+//-----------------------------------------------
+/// the text of the failure's detail field that starts with a count, or NULL
+static const char* FailureSummary(void)
+{
+    _UU32 i;
+
+    for (i = 0; i < Unity.CurrentResult.FieldCount; i++)
+    {
+        if ((Unity.CurrentFields[i].Kind == UNITY_FIELD_DETAIL) && (Unity.CurrentFields[i].String != NULL) &&
+            (Unity.CurrentFields[i].String[0] >= '0') && (Unity.CurrentFields[i].String[0] <= '9'))
+            return Unity.CurrentFields[i].String;
+    }
+    return NULL;
+}
+
+//-----------------------------------------------
+/// fill both buffers alike, then make count random bytes of actual differ
+static void MakeDifferences(const size_t size, const _UU32 count)
+{
+    size_t i;
+
+    for (i = 0; i < sizeof(ExpectedBytes); i++)
+    {
+        ExpectedBytes[i] = (unsigned char)Random();
+    }
+    memcpy(ActualBytes, ExpectedBytes, sizeof(ActualBytes));
+    for (i = 0; (i < count) && (size > 0); i++)
+    {
+        ActualBytes[Random() % size] ^= (unsigned char)(1 + Random() % 255);
+    }
+}
+
+//-----------------------------------------------
+// Memory
+//-----------------------------------------------
+
+/// the first byte that differs, as a plain loop finds it
+static size_t ReferenceFirstDifference(const unsigned char* expected, const unsigned char* actual, const size_t size)
+{
+    size_t i;
+
+    for (i = 0; i < size; i++)
+    {
+        if (expected[i] != actual[i])
+            return i;
+    }
+    return size;
+}
+
+//-----------------------------------------------
+/// how many elements of length bytes differ somewhere
+static _UU32 ReferenceElementsDiffering(const unsigned char* expected, const unsigned char* actual, const _UU32 length, const _UU32 count)
+{
+    _UU32 i, differing = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        if (memcmp(&expected[i * length], &actual[i * length], length) != 0)
+            differing++;
+    }
+    return differing;
+}
+
+//-----------------------------------------------
+static void CheckMemory(const _UU32 length, const _UU32 count, const size_t offset)
+{
+    const unsigned char* expected = &ExpectedBytes[offset];
+    unsigned char* actual = &ActualBytes[(offset * 7) % 32];
+    const size_t size = (size_t)length * count;
+    size_t first;
+    int failed;
+
+    // the actual block starts at its own offset, so the two are aligned differently
+    memmove(actual, &ActualBytes[offset], size);
+    first = ReferenceFirstDifference(expected, actual, size);
+    sprintf(Case, "length %u count %u offset %u", (unsigned)length, (unsigned)count, (unsigned)offset);
+
+    EXPECT_FAILURE(failed, TEST_ASSERT_EQUAL_MEMORY_ARRAY(expected, actual, length, count));
+    TEST_ASSERT_EQUAL_INT_MESSAGE(first < size, failed, Case);
+    if (!failed)
+        return;
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE((count > 1) ? (_U_SINT)(first / length) : -1, FailureNumber(UNITY_FIELD_ELEMENT), Case);
+    TEST_ASSERT_EQUAL_INT_MESSAGE((_U_SINT)(first % length), FailureNumber(UNITY_FIELD_BYTE), Case);
+    TEST_ASSERT_EQUAL_HEX8_MESSAGE(expected[first], FailureNumber(UNITY_FIELD_EXPECTED), Case);
+    TEST_ASSERT_EQUAL_HEX8_MESSAGE(actual[first], FailureNumber(UNITY_FIELD_ACTUAL), Case);
+    if (UnityFullDiff)
+    {
+        TEST_ASSERT_NOT_NULL_MESSAGE(FailureSummary(), Case);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE((count > 1) ? ReferenceElementsDiffering(expected, actual, length, count)
+                                                     : ReferenceElementsDiffering(expected, actual, 1, length),
+                                         (_UU32)strtoul(FailureSummary(), NULL, 10), Case);
+    }
+}
+
+//-----------------------------------------------
+void testMemoryMatchesPlainLoop(void)
+{
+    static const _UU32 lengths[] = { 1, 2, 3, 4, 7, 8, 16, 31, 33, 64 };
+    _UU32 trial, length, count;
+
+    for (trial = 0; trial < TRIALS; trial++)
+    {
+        length = lengths[Random() % (sizeof(lengths) / sizeof(lengths[0]))];
+        count = 1 + Random() % (BUFFER_SIZE / length);
+        MakeDifferences((size_t)length * count, Random() % 4);
+        UnityFullDiff = (int)(trial & 1);
+        CheckMemory(length, count, Random() % 32);
+    }
+    UnityFullDiff = UNITY_FULL_DIFF;
+}
+
+//-----------------------------------------------
+void testMemoryFindsLastByte(void)
+{
+    _UU32 size;
+
+    // a difference in the very last byte sits in every kind of tail the kernels have
+    for (size = 1; size <= 160; size++)
+    {
+        MakeDifferences(0, 0);
+        ActualBytes[size - 1] ^= 0x80;
+        CheckMemory(1, size, 0);
+        CheckMemory(size, 1, 0);
+    }
+}
+
+//-----------------------------------------------
+// Integer Arrays
+//-----------------------------------------------
+
+// the arrays as each width reads them; they share the random bytes of the memory tests
+#define ExpectedInts(type) ((const type*)(const void*)ExpectedWords)
+#define ActualInts(type)   ((const type*)(const void*)ActualWords)
+
+static _UU64 ExpectedWords[BUFFER_SIZE / 8];
+static _UU64 ActualWords[BUFFER_SIZE / 8];
+
+/// the element of width bytes a plain loop finds first, and its values as the width's signed type
+static _UU32 ReferenceFirstElement(const _UU32 width, const _UU32 count, _U_SINT* expected, _U_SINT* actual)
+{
+    _UU32 i;
+
+    for (i = 0; i < count; i++)
+    {
+        switch (width)
+        {
+            case 1:
+                *expected = ExpectedInts(_US8)[i];
+                *actual = ActualInts(_US8)[i];
+                break;
+            case 2:
+                *expected = ExpectedInts(_US16)[i];
+                *actual = ActualInts(_US16)[i];
+                break;
+            case 4:
+                *expected = ExpectedInts(_US32)[i];
+                *actual = ActualInts(_US32)[i];
+                break;
+            default:
+                *expected = ExpectedInts(_US64)[i];
+                *actual = ActualInts(_US64)[i];
+                break;
+        }
+        if (*expected != *actual)
+            return i;
+    }
+    return count;
+}
+
+//-----------------------------------------------
+static void CheckIntArray(const _UU32 width, const int hex, const _UU32 count)
+{
+    _U_SINT expected_value = 0, actual_value = 0;
+    const _UU32 first = ReferenceFirstElement(width, count, &expected_value, &actual_value);
+    int failed = 0;
+
+    sprintf(Case, "width %u count %u%s", (unsigned)width, (unsigned)count, hex ? " hex" : "");
+    switch (width + (hex ? 100 : 0))
+    {
+        case 1:   EXPECT_FAILURE(failed, TEST_ASSERT_EQUAL_INT8_ARRAY(ExpectedInts(_US8), ActualInts(_US8), count)); break;
+        case 2:   EXPECT_FAILURE(failed, TEST_ASSERT_EQUAL_INT16_ARRAY(ExpectedInts(_US16), ActualInts(_US16), count)); break;
+        case 4:   EXPECT_FAILURE(failed, TEST_ASSERT_EQUAL_INT32_ARRAY(ExpectedInts(_US32), ActualInts(_US32), count)); break;
+        case 8:   EXPECT_FAILURE(failed, TEST_ASSERT_EQUAL_INT64_ARRAY(ExpectedInts(_US64), ActualInts(_US64), count)); break;
+        case 101: EXPECT_FAILURE(failed, TEST_ASSERT_EQUAL_HEX8_ARRAY(ExpectedInts(_UU8), ActualInts(_UU8), count)); break;
+        case 102: EXPECT_FAILURE(failed, TEST_ASSERT_EQUAL_HEX16_ARRAY(ExpectedInts(_UU16), ActualInts(_UU16), count)); break;
+        case 104: EXPECT_FAILURE(failed, TEST_ASSERT_EQUAL_HEX32_ARRAY(ExpectedInts(_UU32), ActualInts(_UU32), count)); break;
+        default:  EXPECT_FAILURE(failed, TEST_ASSERT_EQUAL_HEX64_ARRAY(ExpectedInts(_UU64), ActualInts(_UU64), count)); break;
+    }
+    TEST_ASSERT_EQUAL_INT_MESSAGE(first < count, failed, Case);
+    if (!failed)
+        return;
+
+    TEST_ASSERT_EQUAL_INT_MESSAGE(first, FailureNumber(UNITY_FIELD_ELEMENT), Case);
+    TEST_ASSERT_EQUAL_INT64_MESSAGE(expected_value, FailureNumber(UNITY_FIELD_EXPECTED), Case);
+    TEST_ASSERT_EQUAL_INT64_MESSAGE(actual_value, FailureNumber(UNITY_FIELD_ACTUAL), Case);
+    if (UnityFullDiff)
+    {
+        TEST_ASSERT_NOT_NULL_MESSAGE(FailureSummary(), Case);
+        TEST_ASSERT_EQUAL_UINT32_MESSAGE(ReferenceElementsDiffering((const unsigned char*)ExpectedWords, (const unsigned char*)ActualWords, width, count),
+                                         (_UU32)strtoul(FailureSummary(), NULL, 10), Case);
+    }
+}
+
+//-----------------------------------------------
+void testIntArraysMatchPlainLoop(void)
+{
+    _UU32 trial, width, count;
+
+    for (trial = 0; trial < TRIALS; trial++)
+    {
+        width = 1u << (Random() % 4);
+        count = 1 + Random() % (sizeof(ExpectedWords) / width);
+        MakeDifferences((size_t)width * count, Random() % 4);
+        memcpy(ExpectedWords, ExpectedBytes, sizeof(ExpectedWords));
+        memcpy(ActualWords, ActualBytes, sizeof(ActualWords));
+        UnityFullDiff = (int)(trial & 1);
+        CheckIntArray(width, (int)((trial >> 1) & 1), count);
+    }
+    UnityFullDiff = UNITY_FULL_DIFF;
+}
+
+//-----------------------------------------------
+// Floats
+//-----------------------------------------------
+
+#define FLOAT_COUNT (300)
+
+// how badly a NaN or infinity mismatch misses, as in unity.c, so it is always the worst
+#define MISS_SPECIAL (1e300)
+
+static _UF ExpectedFloats[FLOAT_COUNT];
+static _UF ActualFloats[FLOAT_COUNT];
+static _UD ExpectedDoubles[FLOAT_COUNT];
+static _UD ActualDoubles[FLOAT_COUNT];
+static volatile double Zero = 0.0;
+
+// the last mode is the _EQUAL_ arrays' own relative precision
+static const UNITY_TOLERANCE_T Modes[4] = { UNITY_TOLERANCE_ABSOLUTE, UNITY_TOLERANCE_RELATIVE, UNITY_TOLERANCE_ULP, UNITY_TOLERANCE_RELATIVE };
+static const double Tolerances[3][5] =
+{
+    { 0.0, 1e-3, 0.5, 10.0, 1e6 },
+    { 0.0, 1e-6, 1e-4, 0.1, 2.0 },
+    { 0.0, 1.0, 4.0, 3e9, 1e19 }
+};
+
+//-----------------------------------------------
+/// move the bits of a float or double of size bytes by steps ULPs (a NaN or an infinity may come of it)
+static void StepUlps(unsigned char* value, const size_t size, const _US32 steps)
+{
+    _UU32 bits32;
+    _UU64 bits;
+
+    if (size == 4)
+    {
+        memcpy(&bits32, value, 4);
+        bits32 += (_UU32)steps;
+        memcpy(value, &bits32, 4);
+        return;
+    }
+    memcpy(&bits, value, 8);
+    bits += (_UU64)(_US64)steps;
+    memcpy(value, &bits, 8);
+}
+
+//-----------------------------------------------
+static void StoreValue(unsigned char* value, const size_t size, const double number)
+{
+    const float number32 = (float)number;
+
+    memcpy(value, (size == 4) ? (const void*)&number32 : (const void*)&number, size);
+}
+
+//-----------------------------------------------
+static double LoadValue(const unsigned char* value, const size_t size)
+{
+    float number32;
+    double number;
+
+    if (size == 4)
+    {
+        memcpy(&number32, value, 4);
+        return (double)number32;
+    }
+    memcpy(&number, value, 8);
+    return number;
+}
+
+//-----------------------------------------------
+/// fill count pairs of values of size bytes: every actual is up to jitter ULPs off its expected
+/// value, and a few pairs are made to stand out, half of them near the tolerance
+static void MakeValues(unsigned char* expected, unsigned char* actual, const size_t size, const _UU32 count, const _UU32 jitter,
+                       const UNITY_TOLERANCE_T mode, const double tolerance)
+{
+    const double nan = Zero / Zero;
+    const double inf = 1.0 / Zero;
+    unsigned char* exp;
+    unsigned char* act;
+    double value, near;
+    _UU32 i, outliers;
+
+    for (i = 0; i < count; i++)
+    {
+        StoreValue(&expected[i * size], size, ((double)(Random() % 2000001) - 1000000.0) * ((Random() & 1) ? 1e-3 : 1e-6));
+        memcpy(&actual[i * size], &expected[i * size], size);
+        StepUlps(&actual[i * size], size, (_US32)(Random() % (2 * jitter + 1)) - (_US32)jitter);
+    }
+
+    for (outliers = Random() % 4; outliers > 0; outliers--)
+    {
+        i = Random() % count;
+        exp = &expected[i * size];
+        act = &actual[i * size];
+        near = tolerance * (double)(1 + Random() % 5) * 0.5;
+        switch (Random() % 16)
+        {
+            case 0: StoreValue(exp, size, nan);  StoreValue(act, size, nan);  break;
+            case 1: StoreValue(exp, size, -inf); StoreValue(act, size, -inf); break;
+            case 2: StoreValue(exp, size, nan);  break;
+            case 3: StoreValue(act, size, inf);  break;
+            case 4: StoreValue(exp, size, -Zero); StoreValue(act, size, 0.0); StepUlps(act, size, (_US32)(Random() % 3)); break;
+            case 5: StoreValue(exp, size, 1e-42); memcpy(act, exp, size); StepUlps(act, size, (_US32)(Random() % 9) - 4); break;
+            case 6: memcpy(act, exp, size); StepUlps(act, size, (_US32)(Random() % 4096)); break;
+            case 7: StoreValue(act, size, ((double)(Random() % 2001) - 1000.0) * 1e-2); break;
+            default:
+                value = LoadValue(exp, size);
+                if (mode == UNITY_TOLERANCE_ULP)
+                {
+                    memcpy(act, exp, size);
+                    StepUlps(act, size, (near < 1e9) ? (_US32)near : 1000000000);
+                }
+                else
+                {
+                    StoreValue(act, size, (mode == UNITY_TOLERANCE_ABSOLUTE) ? (value + near) : (value * (1.0 + near)));
+                }
+                break;
+        }
+    }
+}
+
+//-----------------------------------------------
+/// the distance in ULPs between the values of two float or double bit patterns, with -0 == +0
+static _UU64 ReferenceUlps(const _UU64 expected, const _UU64 actual, const _UU64 sign)
+{
+    const _UU64 ordinal_exp = (expected & sign) ? (sign - (expected & ~sign)) : (sign + expected);
+    const _UU64 ordinal_act = (actual & sign) ? (sign - (actual & ~sign)) : (sign + actual);
+
+    return (ordinal_exp > ordinal_act) ? (ordinal_exp - ordinal_act) : (ordinal_act - ordinal_exp);
+}
+
+//-----------------------------------------------
+/// how badly actual misses expected, in the units of the mode, or 0 if it does not
+static double ReferenceFloatMiss(const _UF expected, const _UF actual, const _UF tolerance, const UNITY_TOLERANCE_T mode)
+{
+    const int nan_exp = (expected != expected), nan_act = (actual != actual);
+    _UU32 bits_exp, bits_act;
+    _UU64 ulps;
+    _UF diff, magnitude;
+
+    if (nan_exp || nan_act)
+        return (nan_exp && nan_act) ? 0.0 : MISS_SPECIAL;
+    if ((expected * 0 != 0) || (actual * 0 != 0))
+        return (expected == actual) ? 0.0 : MISS_SPECIAL;
+    if (mode == UNITY_TOLERANCE_ULP)
+    {
+        memcpy(&bits_exp, &expected, 4);
+        memcpy(&bits_act, &actual, 4);
+        ulps = ReferenceUlps(bits_exp, bits_act, 0x80000000u);
+        return ((double)ulps > (double)tolerance) ? (double)ulps : 0.0;
+    }
+
+    diff = (expected > actual) ? (expected - actual) : (actual - expected);
+    magnitude = (expected < 0) ? -expected : expected;
+    if (mode == UNITY_TOLERANCE_ABSOLUTE)
+        return (diff > tolerance) ? (double)diff : 0.0;
+    if (diff <= tolerance * magnitude)
+        return 0.0;
+    return (magnitude > 0) ? ((double)diff / (double)magnitude) : MISS_SPECIAL;
+}
+
+//-----------------------------------------------
+static double ReferenceDoubleMiss(const _UD expected, const _UD actual, const _UD tolerance, const UNITY_TOLERANCE_T mode)
+{
+    const int nan_exp = (expected != expected), nan_act = (actual != actual);
+    _UU64 bits_exp, bits_act, ulps;
+    _UD diff, magnitude;
+
+    if (nan_exp || nan_act)
+        return (nan_exp && nan_act) ? 0.0 : MISS_SPECIAL;
+    if ((expected * 0 != 0) || (actual * 0 != 0))
+        return (expected == actual) ? 0.0 : MISS_SPECIAL;
+    if (mode == UNITY_TOLERANCE_ULP)
+    {
+        memcpy(&bits_exp, &expected, 8);
+        memcpy(&bits_act, &actual, 8);
+        ulps = ReferenceUlps(bits_exp, bits_act, 0x8000000000000000ull);
+        return ((double)ulps > (double)tolerance) ? (double)ulps : 0.0;
+    }
+
+    diff = (expected > actual) ? (expected - actual) : (actual - expected);
+    magnitude = (expected < 0) ? -expected : expected;
+    if (mode == UNITY_TOLERANCE_ABSOLUTE)
+        return (diff > tolerance) ? (double)diff : 0.0;
+    if (diff <= tolerance * magnitude)
+        return 0.0;
+    return (magnitude > 0) ? ((double)diff / (double)magnitude) : MISS_SPECIAL;
+}
+
+//-----------------------------------------------
+/// the failure must count the misses the reference does and name the worst (the first, of equals)
+static void CheckFloatFailure(const int failed, const double* misses, const _UU32 count)
+{
+    _UU32 i, total = 0, worst = 0;
+
+    for (i = 0; i < count; i++)
+    {
+        if (misses[i] > 0.0)
+            total++;
+        if (misses[i] > misses[worst])
+            worst = i;
+    }
+    TEST_ASSERT_EQUAL_INT_MESSAGE(total > 0, failed, Case);
+    if (!failed)
+        return;
+
+    TEST_ASSERT_NOT_NULL_MESSAGE(FailureSummary(), Case);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(total, (_UU32)strtoul(FailureSummary(), NULL, 10), Case);
+    TEST_ASSERT_EQUAL_INT_MESSAGE(worst, FailureNumber(UNITY_FIELD_ELEMENT), Case);
+}
+
+//-----------------------------------------------
+void testFloatArraysMatchPlainLoop(void)
+{
+    static double misses[FLOAT_COUNT];
+    _UU32 trial, count, i, mode;
+    _UF tolerance;
+    int failed = 0;
+
+    for (trial = 0; trial < TRIALS; trial++)
+    {
+        mode = Random() % 4;
+        tolerance = (mode < 3) ? (_UF)Tolerances[mode][Random() % 5] : (_UF)UNITY_FLOAT_PRECISION;
+        count = 1 + Random() % FLOAT_COUNT;
+        MakeValues((unsigned char*)ExpectedFloats, (unsigned char*)ActualFloats, sizeof(_UF), count, Random() % 6, Modes[mode], (double)tolerance);
+        UnityFullDiff = (int)(trial & 1);
+        sprintf(Case, "float mode %u tolerance %g count %u", (unsigned)mode, (double)tolerance, (unsigned)count);
+
+        switch (mode)
+        {
+            case 0:  EXPECT_FAILURE(failed, TEST_ASSERT_FLOAT_ARRAY_WITHIN(tolerance, ExpectedFloats, ActualFloats, count)); break;
+            case 1:  EXPECT_FAILURE(failed, TEST_ASSERT_FLOAT_ARRAY_WITHIN_REL(tolerance, ExpectedFloats, ActualFloats, count)); break;
+            case 2:  EXPECT_FAILURE(failed, TEST_ASSERT_FLOAT_ARRAY_WITHIN_ULP(tolerance, ExpectedFloats, ActualFloats, count)); break;
+            default: EXPECT_FAILURE(failed, TEST_ASSERT_EQUAL_FLOAT_ARRAY(ExpectedFloats, ActualFloats, count)); break;
+        }
+        for (i = 0; i < count; i++)
+        {
+            misses[i] = ReferenceFloatMiss(ExpectedFloats[i], ActualFloats[i], tolerance, Modes[mode]);
+        }
+        CheckFloatFailure(failed, misses, count);
+    }
+    UnityFullDiff = UNITY_FULL_DIFF;
+}
+
+//-----------------------------------------------
+void testDoubleArraysMatchPlainLoop(void)
+{
+    static double misses[FLOAT_COUNT];
+    _UU32 trial, count, i, mode;
+    _UD tolerance;
+    int failed = 0;
+
+    for (trial = 0; trial < TRIALS; trial++)
+    {
+        mode = Random() % 4;
+        tolerance = (mode < 3) ? (_UD)Tolerances[mode][Random() % 5] : (_UD)UNITY_DOUBLE_PRECISION;
+        count = 1 + Random() % FLOAT_COUNT;
+        MakeValues((unsigned char*)ExpectedDoubles, (unsigned char*)ActualDoubles, sizeof(_UD), count, Random() % 6, Modes[mode], (double)tolerance);
+        UnityFullDiff = (int)(trial & 1);
+        sprintf(Case, "double mode %u tolerance %g count %u", (unsigned)mode, (double)tolerance, (unsigned)count);
+
+        switch (mode)
+        {
+            case 0:  EXPECT_FAILURE(failed, TEST_ASSERT_DOUBLE_ARRAY_WITHIN(tolerance, ExpectedDoubles, ActualDoubles, count)); break;
+            case 1:  EXPECT_FAILURE(failed, TEST_ASSERT_DOUBLE_ARRAY_WITHIN_REL(tolerance, ExpectedDoubles, ActualDoubles, count)); break;
+            case 2:  EXPECT_FAILURE(failed, TEST_ASSERT_DOUBLE_ARRAY_WITHIN_ULP(tolerance, ExpectedDoubles, ActualDoubles, count)); break;
+            default: EXPECT_FAILURE(failed, TEST_ASSERT_EQUAL_DOUBLE_ARRAY(ExpectedDoubles, ActualDoubles, count)); break;
+        }
+        for (i = 0; i < count; i++)
+        {
+            misses[i] = ReferenceDoubleMiss(ExpectedDoubles[i], ActualDoubles[i], tolerance, Modes[mode]);
+        }
+        CheckFloatFailure(failed, misses, count);
+    }
+    UnityFullDiff = UNITY_FULL_DIFF;
+}
+
+//-----------------------------------------------
+int main(void)
+{
+    Unity.TestFile = "test_kernels.c";
+    UnityBegin();
+    RUN_TEST(testMemoryMatchesPlainLoop, 173);
+    RUN_TEST(testMemoryFindsLastByte, 190);
+    RUN_TEST(testIntArraysMatchPlainLoop, 282);
+    RUN_TEST(testFloatArraysMatchPlainLoop, 508);
+    RUN_TEST(testDoubleArraysMatchPlainLoop, 541);
+    return UnityEnd();
+}
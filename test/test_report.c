@@ -0,0 +1,110 @@
+/* ==========================================
+    Unity Project - A Test Framework for C
+    Copyright (c) 2007 Mike Karlesky, Mark VanderVoord, Greg Williams
+    [Released under MIT License. Please refer to license.txt for details]
+========================================== */
+
+// A suite whose tests pass, fail and are ignored in every way that reports
+// a field of its own, for selftest.sh to run under different builds and
+// options and compare what each reports.  It takes Unity's options, and the
+// exit status is the number of failures.
+
+#include "unity.h"
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+static const unsigned char ExpectedBytes[6] = { 1, 2, 3, 4, 5, 6 };
+static const unsigned char ActualBytes[6]   = { 1, 2, 3, 4, 9, 6 };
+static const int ExpectedInts[5] = { 10, 20, 30, 40, 50 };
+static const int ActualInts[5]   = { 10, 20, -30, 40, 51 };
+
+void testPasses(void)
+{
+    TEST_ASSERT_EQUAL_INT(42, 42);
+    TEST_ASSERT_BITS(0xF0, 0x35, 0x3A);
+    TEST_ASSERT_INT_WITHIN(2, 100, 101);
+    TEST_ASSERT_EQUAL_STRING("same", "same");
+}
+
+void testEqualInt(void)
+{
+    TEST_ASSERT_EQUAL_INT(-12345, 678);
+}
+
+void testEqualUint(void)
+{
+    TEST_ASSERT_EQUAL_UINT(200, 4000000000u);
+}
+
+void testEqualHex16(void)
+{
+    TEST_ASSERT_EQUAL_HEX16_MESSAGE(0xBEEF, 0xBEAD, "with a message");
+}
+
+void testBits(void)
+{
+    TEST_ASSERT_BITS(0x0FF0, 0x1234, 0x1324);
+}
+
+void testWithin(void)
+{
+    TEST_ASSERT_INT_WITHIN(5, 1000, 1010);
+}
+
+void testString(void)
+{
+    TEST_ASSERT_EQUAL_STRING("a \"quoted\"\tline\n", "a \"quoted\" line\n");
+}
+
+void testMemory(void)
+{
+    TEST_ASSERT_EQUAL_MEMORY_ARRAY(ExpectedBytes, ActualBytes, 2, 3);
+}
+
+void testIntArray(void)
+{
+    TEST_ASSERT_EQUAL_INT_ARRAY(ExpectedInts, ActualInts, 5);
+}
+
+void testFloat(void)
+{
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 1.5f, 1.75f);
+}
+
+void testFail(void)
+{
+    TEST_FAIL_MESSAGE("failed on purpose");
+}
+
+void testIgnored(void)
+{
+    TEST_IGNORE_MESSAGE("not this time");
+}
+
+void testPassesToo(void)
+{
+    TEST_ASSERT_TRUE(1);
+}
+
+int main(int argc, char* argv[])
+{
+    Unity.TestFile = "test_report.c";
+    UnityParseOptions(argc, argv);
+    UnityBegin();
+    RUN_TEST(testPasses, 23);
+    RUN_TEST(testEqualInt, 31);
+    RUN_TEST(testEqualUint, 36);
+    RUN_TEST(testEqualHex16, 41);
+    RUN_TEST(testBits, 46);
+    RUN_TEST(testWithin, 51);
+    RUN_TEST(testString, 56);
+    RUN_TEST(testMemory, 61);
+    RUN_TEST(testIntArray, 66);
+    RUN_TEST(testFloat, 71);
+    RUN_TEST(testFail, 76);
+    RUN_TEST(testIgnored, 81);
+    RUN_TEST(testPassesToo, 86);
+    return UnityEnd();
+}
@@ -0,0 +1,226 @@
+/* ==========================================
+    Unity Project - A Test Framework for C
+    Copyright (c) 2007 Mike Karlesky, Mark VanderVoord, Greg Williams
+    [Released under MIT License. Please refer to license.txt for details]
+========================================== */
+
+// Checks which tests a run selects.  A suite of generated test names is
+// run as every shard of every count up to MAX_SHARDS, and each test must run
+// in exactly one shard of each count: the one FNV-1a of "file:name", worked
+// out again here, picks.  The --include and --exclude patterns given to the
+// program apply too, and a test must run only if a plain recursive matcher
+// here picks it as well.  selftest.sh runs it with several sets of patterns;
+// they should leave this file's own tests alone.
+
+#include "unity.h"
+#include <stdio.h>
+#include <string.h>
+
+void setUp(void) {}
+void tearDown(void) {}
+
+#define TEST_COUNT (500)
+#define MAX_SHARDS (9)
+
+static char Names[TEST_COUNT][24];
+static _UU32 Current;
+
+// for every count, how often each test ran and the shard it last ran in
+static _UU32 Runs[MAX_SHARDS + 1][TEST_COUNT];
+static _UU32 RanIn[MAX_SHARDS + 1][TEST_COUNT];
+
+static char Case[64];
+
+// the patterns given, to match again here
+#define MAX_OPTIONS (16)
+static const char* Includes[MAX_OPTIONS];
+static const char* Excludes[MAX_OPTIONS];
+static int IncludeCount = 0;
+static int ExcludeCount = 0;
+
+//-----------------------------------------------
+// Helpers
+//-----------------------------------------------
+
+/// FNV-1a of "file:name", written out plainly
+static _UU32 ReferenceHash(const char* file, const char* name)
+{
+    char key[128];
+    const char* ch;
+    _UU32 hash = 2166136261u;
+
+    sprintf(key, "%s:%s", file, name);
+    for (ch = key; *ch != '\0'; ch++)
+    {
+        hash ^= (unsigned char)*ch;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+//-----------------------------------------------
+/// '*' matches any run of characters and '?' any one, tried every way there is
+static int ReferenceGlob(const char* pattern, const char* name)
+{
+    if (*pattern == '\0')
+        return (*name == '\0');
+    if (*pattern == '*')
+        return ReferenceGlob(pattern + 1, name) || ((*name != '\0') && ReferenceGlob(pattern, name + 1));
+    if ((*name != '\0') && ((*pattern == '?') || (*pattern == *name)))
+        return ReferenceGlob(pattern + 1, name + 1);
+    return 0;
+}
+
+//-----------------------------------------------
+/// whether any of the comma separated patterns in the lists matches name; patterns counts them
+static int ReferenceMatch(const char** lists, const int count, const char* name, int* patterns)
+{
+    char pattern[256];
+    const char* start;
+    const char* end;
+    int matched = 0;
+    int i;
+
+    for (i = 0; i < count; i++)
+    {
+        for (start = lists[i]; start != NULL; start = (*end == ',') ? end + 1 : NULL)
+        {
+            end = start + strcspn(start, ",");
+            if (end == start)
+                continue;
+            sprintf(pattern, "%.*s", (int)(end - start), start);
+            (*patterns)++;
+            matched |= ReferenceGlob(pattern, name);
+        }
+    }
+    return matched;
+}
+
+//-----------------------------------------------
+/// whether the patterns given let the test run: any include matches, or none was given, and no exclude does
+static int ReferenceSelected(const char* name)
+{
+    int includes = 0;
+    int excludes = 0;
+    const int included = ReferenceMatch(Includes, IncludeCount, name, &includes);
+
+    return (included || (includes == 0)) && !ReferenceMatch(Excludes, ExcludeCount, name, &excludes);
+}
+
+//-----------------------------------------------
+/// note the patterns given as --include/--exclude PATTERNS or --include/--exclude=PATTERNS
+static void ReadPatterns(int argc, char* argv[])
+{
+    int i;
+
+    for (i = 1; i < argc; i++)
+    {
+        const int include = (strncmp(argv[i], "--include", 9) == 0);
+        const char** list = include ? Includes : Excludes;
+        int* count = include ? &IncludeCount : &ExcludeCount;
+
+        if (!include && (strncmp(argv[i], "--exclude", 9) != 0))
+            continue;
+        if ((argv[i][9] == '=') && (*count < MAX_OPTIONS))
+            list[(*count)++] = &argv[i][10];
+        else if ((argv[i][9] == '\0') && (i + 1 < argc) && (*count < MAX_OPTIONS))
+            list[(*count)++] = argv[++i];
+    }
+}
+
+//-----------------------------------------------
+static void RecordRun(void)
+{
+    Runs[UnityShardCount][Current]++;
+    RanIn[UnityShardCount][Current] = UnityShardIndex;
+}
+
+//-----------------------------------------------
+/// run the generated suite as every shard of every count, quietly and without counting it
+static void RunShards(void)
+{
+    const UNITY_COUNTER_TYPE tests = Unity.NumberOfTests;
+    _UU32 count, index;
+
+    UnityClearSinks();
+    UnityAddSink(&UnitySinkNone);
+    for (count = 1; count <= MAX_SHARDS; count++)
+    {
+        for (index = 0; index < count; index++)
+        {
+            UnityShardIndex = index;
+            UnityShardCount = count;
+            for (Current = 0; Current < TEST_COUNT; Current++)
+            {
+                UnityDefaultTestRun(RecordRun, Names[Current], 1);
+            }
+        }
+    }
+    UnityShardIndex = 0;
+    UnityShardCount = 0;
+    UnityClearSinks();
+    UnityAddSink(&UnitySinkConsole);
+    Unity.NumberOfTests = tests;
+}
+
+//-----------------------------------------------
+// Tests
+//-----------------------------------------------
+
+void testEverySelectedTestRunsInOneShardOfEachCount(void)
+{
+    _UU32 count, i;
+
+    for (count = 1; count <= MAX_SHARDS; count++)
+    {
+        for (i = 0; i < TEST_COUNT; i++)
+        {
+            sprintf(Case, "%s of %u shards", Names[i], (unsigned)count);
+            TEST_ASSERT_EQUAL_UINT32_MESSAGE(ReferenceSelected(Names[i]) ? 1 : 0, Runs[count][i], Case);
+        }
+    }
+}
+
+//-----------------------------------------------
+void testShardIsPickedByFnv1aOfFileAndName(void)
+{
+    _UU32 count, i;
+
+    for (count = 2; count <= MAX_SHARDS; count++)
+    {
+        for (i = 0; i < TEST_COUNT; i++)
+        {
+            if (Runs[count][i] == 0)
+                continue;
+            sprintf(Case, "%s of %u shards", Names[i], (unsigned)count);
+            TEST_ASSERT_EQUAL_UINT32_MESSAGE(ReferenceHash(Unity.TestFile, Names[i]) % count, RanIn[count][i], Case);
+        }
+    }
+}
+
+//-----------------------------------------------
+int main(int argc, char* argv[])
+{
+    // this file's own tests run whichever names were asked for
+    static char* own[] = { "test_select", "--include", "testEverySelectedTestRunsInOneShardOfEachCount,testShardIsPickedByFnv1aOfFileAndName" };
+    int includes = 0;
+    _UU32 i;
+
+    for (i = 0; i < TEST_COUNT; i++)
+    {
+        sprintf(Names[i], "test%c%u", 'A' + (int)(i % 26), (unsigned)(i * 7919u));
+    }
+
+    Unity.TestFile = "test_select.c";
+    ReadPatterns(argc, argv);
+    UnityParseOptions(argc, argv);
+    ReferenceMatch(Includes, IncludeCount, "", &includes);
+    if (includes > 0)
+        UnityParseOptions(3, own);
+    UnityAddSink(&UnitySinkConsole);
+    UnityBegin();
+    RunShards();
+    RUN_TEST(testEverySelectedTestRunsInOneShardOfEachCount, 170);
+    RUN_TEST(testShardIsPickedByFnv1aOfFileAndName, 185);
+    return UnityEnd();
+}
@@ -4,21 +4,141 @@
     [Released under MIT License. Please refer to license.txt for details]
 ========================================== */
 
+// the crash flush is built on sigaction() and write(), so it is left out where they are missing
+#if !defined(UNITY_EXCLUDE_CRASH_FLUSH) && !defined(__unix__) && !defined(__APPLE__)
+#define UNITY_EXCLUDE_CRASH_FLUSH
+#endif
+#if defined(UNITY_SUPPORT_FORK) || (defined(UNITY_SUPPORT_TIMING) && (!defined(UNITY_CLOCK_NS) || !defined(UNITY_CPU_CLOCK_NS)))
+#define UNITY_POSIX_CLOCK
+#endif
+// on Linux each thread's timeout timer signals that thread alone, which needs syscall(SYS_gettid)
+#if defined(UNITY_SUPPORT_TIMEOUTS) && defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+#if (!defined(UNITY_EXCLUDE_CRASH_FLUSH) || defined(UNITY_SUPPORT_FORK) || defined(UNITY_POSIX_CLOCK) || defined(UNITY_REPORT_MMAP) || defined(UNITY_SUPPORT_CACHE) || defined(UNITY_SUPPORT_TIMEOUTS)) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
 #include "unity.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#ifndef UNITY_EXCLUDE_CRASH_FLUSH
+#include <signal.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+#ifdef UNITY_SUPPORT_THREADS
+#include <pthread.h>
+#include <unistd.h>
+#endif
+#ifdef UNITY_SUPPORT_FORK
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+#ifdef UNITY_POSIX_CLOCK
+#include <time.h>
+#endif
+#ifdef UNITY_REPORT_MMAP
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#ifdef UNITY_SUPPORT_CACHE
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+#ifdef UNITY_SUPPORT_TIMEOUTS
+#include <signal.h>
+#include <time.h>
+#if defined(__linux__) && defined(SIGEV_THREAD_ID)
+#include <sys/syscall.h>
+#include <unistd.h>
+#define UNITY_WATCHDOG_PER_THREAD
+// older C libraries leave the Linux name of the thread id out
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+#endif
+#endif
+#ifndef UNITY_EXCLUDE_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define UNITY_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#define UNITY_SIMD_AVX2
+#include <immintrin.h>
+#elif defined(UNITY_SIMD_SSE2) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+// built without -mavx2: compile the AVX2 kernel anyway and pick it at run time
+#define UNITY_SIMD_AVX2_DISPATCH
+#include <immintrin.h>
+#endif
+#endif
 
-#define UNITY_FAIL_AND_BAIL   { Unity.CurrentTestFailed  = 1; UNITY_OUTPUT_CHAR('\n',1); UNITY_OUTPUT_CHAR('\n',0);  longjmp(Unity.AbortFrame, 1); }
-#define UNITY_IGNORE_AND_BAIL { Unity.CurrentTestIgnored = 1; UNITY_OUTPUT_CHAR('\n',1); UNITY_OUTPUT_CHAR('\n',0); longjmp(Unity.AbortFrame, 1); }
+/// the result itself is reported by UnityConcludeTest once the test has unwound
+#define UNITY_FAIL_AND_BAIL   { Unity.CurrentTestFailed  = 1; longjmp(Unity.AbortFrame, 1); }
+#define UNITY_IGNORE_AND_BAIL { Unity.CurrentTestIgnored = 1; longjmp(Unity.AbortFrame, 1); }
 /// return prematurely if we are already in failure or ignore state
 #define UNITY_SKIP_EXECUTION  { if ((Unity.CurrentTestFailed != 0) || (Unity.CurrentTestIgnored != 0)) {return;} }
-#define UNITY_PRINT_EOL       { UNITY_OUTPUT_CHAR('\n',1); UNITY_OUTPUT_CHAR('\n',0);}
+#define UNITY_PRINT_EOL       { UNITY_OUTPUT_CHAR('\n',UNITY_CHANNEL_CONSOLE); }
 
-struct _Unity Unity = { 0 };
+#ifdef UNITY_SUPPORT_TIMING
+#ifndef UNITY_CLOCK_NS
+#define UNITY_CLOCK_NS()     ((_UT)UnityClockNs(CLOCK_MONOTONIC))
+#endif
+#ifndef UNITY_CPU_CLOCK_NS
+#define UNITY_CPU_CLOCK_NS() ((_UT)UnityClockNs(CLOCK_THREAD_CPUTIME_ID))
+#endif
+#define UNITY_TIMING_BEGIN()        UnityTimingBegin()
+#define UNITY_TIMING_SWITCH(phase)  UnityTimingSwitch(phase)
+#define UNITY_TIMING_END()          UnityTimingEnd()
+#else
+#define UNITY_TIMING_BEGIN()
+#define UNITY_TIMING_SWITCH(phase)
+#define UNITY_TIMING_END()
+#endif
+
+#ifdef UNITY_SUPPORT_CACHE
+#define UNITY_CACHE_KEEP(text, length, index)  UnityCacheKeep(text, length, index)
+#define UNITY_CACHE_REPLAYING()                UnityCacheReplaying()
+#else
+#define UNITY_CACHE_KEEP(text, length, index)
+#define UNITY_CACHE_REPLAYING()                (0)
+#endif
+
+#ifndef UNITY_EXCLUDE_CRASH_FLUSH
+#define UNITY_CRASH_FLUSH_REMOVE()              UnityRemoveCrashFlush()
+#define UNITY_CRASH_FLUSH_ACTIVE()              (UnityCrashInstalled)
+#else
+#define UNITY_CRASH_FLUSH_REMOVE()
+#define UNITY_CRASH_FLUSH_ACTIVE()              (0)
+#endif
+
+#ifdef UNITY_SUPPORT_TIMEOUTS
+#define UNITY_WATCHDOG_BEGIN()     { UnityWatchdogLimit = UnityTestTimeout; UnityWatchdogArm(UnityTestTimeout); }
+#define UNITY_WATCHDOG_TEARDOWN()  { if (UnityWatchdogFired) UnityWatchdogArm(UnityWatchdogLimit); }
+#define UNITY_WATCHDOG_END()       { UnityWatchdogDisarm(); UnityWatchdogConclude(); }
+#else
+#define UNITY_WATCHDOG_BEGIN()
+#define UNITY_WATCHDOG_TEARDOWN()
+#define UNITY_WATCHDOG_END()
+#endif
+
+UNITY_THREAD_LOCAL struct _Unity Unity = { 0 };
 
 const char* UnityStrNull     = "NULL";
 const char* UnityStrSpacer   = ". ";
-const char* UnityStrExpected[2] = {" \"Message\":\"Expected ","Expected"};
+const char* UnityStrExpected = " Expected ";
 const char* UnityStrWas      = " Was ";
 const char* UnityStrTo       = " To ";
 const char* UnityStrElement  = " Element ";
@@ -46,1114 +166,6006 @@ const _U_UINT UnitySizeMask[] =
 
 void UnityPrintFail(void);
 void UnityPrintOk(void);
+static void UnityCloseJUnit(void);
+static void UnityTrackHistory(const struct _UnityResult* result);
+#ifdef UNITY_SUPPORT_CACHE
+static void UnityCacheKeep(const char* text, const size_t length, const _US32 index);
+static int UnityCacheReplaying(void);
+static void UnityCacheSegment(const char* file);
+#endif
 
-int put_char(int a, _US32 index){
-    FILE* fp;
-    if (index==1) {
-        putchar(a);
-    }
-    else
-    {
-        char filename[256]="";
-        strcat(filename,Unity.TestFile);
-        strcat(filename,".json");
-        fp = fopen(filename,"a");
-        fputc( a, fp);
-        fclose(fp);
-    }
-    return 0;
+//-----------------------------------------------
+/// whether two results came from the same test file; the names are usually the same literal
+static int UnitySameFile(const char* a, const char* b)
+{
+    if ((a == b) || (a == NULL) || (b == NULL))
+        return (a == b);
+    return (strcmp(a, b) == 0);
 }
+
 //-----------------------------------------------
-// Pretty Printers & Test Result Output Handlers
+// JSON Report File
 //-----------------------------------------------
 
-void UnityPrint(const char* string, _US32 index)
+#if defined(UNITY_REPORT_BINARY)
+#define UNITY_REPORT_EXTENSION ".ulog"
+#elif defined(UNITY_REPORT_JSON_LINES)
+#define UNITY_REPORT_EXTENSION ".jsonl"
+#else
+#define UNITY_REPORT_EXTENSION ".json"
+#endif
+
+// The report is opened when a record names its test file and written through
+// this buffer.  stdio buffering is switched off, so each flush is one write.
+static FILE* UnityReportFile = NULL;
+static int   UnityReportOut = -1;   // its descriptor, for the crash flush
+static char  UnityReportBuffer[UNITY_REPORT_BUFFER_SIZE];
+
+// The test file the report is named after, once a record has named one; a
+// record from another file closes the report and starts that file's own
+static char UnityReportName[256 - sizeof(UNITY_REPORT_EXTENSION)];
+static int  UnityReportNamed = 0;
+
+// Where report output goes: the buffer above, or the mapped report itself, in
+// which case UnityReportUsed is the end of the report in the file
+static char*  UnityReportData = UnityReportBuffer;
+static size_t UnityReportSize = sizeof(UnityReportBuffer);
+static size_t UnityReportUsed = 0;
+
+#ifdef UNITY_REPORT_MMAP
+// The mapped report is reserved a chunk past what has been written, so records
+// are written without any system calls until a chunk fills up and the next
+// window is mapped.  A run that is killed leaves its records followed by zeros;
+// UnityEnd() trims them off.
+static int   UnityReportFd = -1;
+static off_t UnityReportBase = 0;   // file offset of UnityReportData[0]
+
+//-----------------------------------------------
+/// map a window from the end of the report with at least room bytes (and a chunk) free; 0 if it cannot be
+static int UnityMapReport(const size_t room)
 {
-    const char* pch = string;
+    const off_t page = (off_t)sysconf(_SC_PAGESIZE);
+    const off_t end = UnityReportBase + (off_t)UnityReportUsed;
+    const off_t base = end - (end % page);
+    size_t size = UNITY_REPORT_MMAP_CHUNK;
+    char* map;
+    int flags = MAP_SHARED;
 
-    if (pch != NULL)
+    // a report that keeps growing gets windows twice as large each time, up to 16 chunks
+    if ((UnityReportData != UnityReportBuffer) && (UnityReportSize < 16 * (size_t)UNITY_REPORT_MMAP_CHUNK))
+        size = 2 * UnityReportSize;
+    else if (UnityReportData != UnityReportBuffer)
+        size = UnityReportSize;
+    if (size < room)
+        size = room;
+    size += (size_t)(end - base);
+
+    size = ((size + (size_t)page - 1) / (size_t)page) * (size_t)page;
+    // file systems without fallocate still get a (sparse) file of the right size
+    if ((posix_fallocate(UnityReportFd, base, (off_t)size) != 0) && (ftruncate(UnityReportFd, base + (off_t)size) != 0))
+        return 0;
+
+#ifdef MAP_POPULATE
+    // fault the whole window in at once rather than a page at a time as it is written
+    flags |= MAP_POPULATE;
+#endif
+    map = (char*)mmap(NULL, size, PROT_READ | PROT_WRITE, flags, UnityReportFd, base);
+    if (map == (char*)MAP_FAILED)
+        return 0;
+
+    if (UnityReportData != UnityReportBuffer)
     {
-        while (*pch)
-        {
-            // printable characters plus CR & LF are printed
-            if ((*pch <= 126) && (*pch >= 32))
-            {
-                UNITY_OUTPUT_CHAR(*pch, index);
-            }
-            //write escaped carriage returns
-            else if (*pch == 13)
-            {
-                UNITY_OUTPUT_CHAR('\\', index);
-                UNITY_OUTPUT_CHAR('r', index);
-            }
-            //write escaped line feeds
-            else if (*pch == 10)
-            {
-                UNITY_OUTPUT_CHAR('\\',index);
-                UNITY_OUTPUT_CHAR('n',index);
-            }
-            // unprintable characters are shown as codes
-            else
-            {
-                UNITY_OUTPUT_CHAR('\\',index);
-                UnityPrintNumberHex((_U_SINT)*pch, 2, index);
-            }
-            pch++;
-        }
+        munmap(UnityReportData, UnityReportSize);
     }
+    UnityReportData = map;
+    UnityReportSize = size;
+    UnityReportUsed = (size_t)(end - base);
+    UnityReportBase = base;
+    return 1;
 }
 
 //-----------------------------------------------
-void UnityPrintNumberByStyle(const _U_SINT number, const UNITY_DISPLAY_STYLE_T style, _US32 index)
+/// cut the reserved tail off, so the file ends with the last record written
+static int UnityTrimReport(void)
 {
-    if ((style & UNITY_DISPLAY_RANGE_INT) == UNITY_DISPLAY_RANGE_INT)
-    {
-        UnityPrintNumber(number,index);
-    }
-    else if ((style & UNITY_DISPLAY_RANGE_UINT) == UNITY_DISPLAY_RANGE_UINT)
-    {
-        UnityPrintNumberUnsigned(  (_U_UINT)number  &  UnitySizeMask[((_U_UINT)style & (_U_UINT)0x0F) - 1], index  );
-    }
-    else
-    {
-        UnityPrintNumberHex((_U_UINT)number, (style & 0x000F) << 1, index);
-    }
+    return (UnityReportFd < 0) || (ftruncate(UnityReportFd, UnityReportBase + (off_t)UnityReportUsed) == 0);
 }
 
 //-----------------------------------------------
-/// basically do an itoa using as little ram as possible
-void UnityPrintNumber(const _U_SINT number_to_print, _US32 index)
+static void UnityUnmapReport(void)
 {
-    _U_SINT divisor = 1;
-    _U_SINT next_divisor;
-    _U_SINT number = number_to_print;
+    if (UnityReportFd < 0)
+        return;
 
-    if (number < 0)
+    if (UnityReportData != UnityReportBuffer)
     {
-        UNITY_OUTPUT_CHAR('-',index);
-        number = -number;
+        munmap(UnityReportData, UnityReportSize);
     }
+    UnityTrimReport();
+    close(UnityReportFd);
+    UnityReportFd = -1;
+    UnityReportData = UnityReportBuffer;
+    UnityReportSize = sizeof(UnityReportBuffer);
+    UnityReportUsed = 0;
+    UnityReportBase = 0;
+}
+
+//-----------------------------------------------
+/// open and map the report, appending to what it already holds; 0 to fall back to stdio
+static int UnityOpenMappedReport(const char* filename)
+{
+    struct stat status;
+    const size_t pending = UnityReportUsed;
 
-    // figure out initial divisor
-    while (number / divisor > 9)
+    UnityReportFd = open(filename, O_RDWR | O_CREAT, 0666);
+    if (UnityReportFd < 0)
+        return 0;
+
+    if (fstat(UnityReportFd, &status) != 0)
     {
-        next_divisor = divisor * 10;
-        if (next_divisor > divisor)
-            divisor = next_divisor;
-        else
-            break;
+        close(UnityReportFd);
+        UnityReportFd = -1;
+        return 0;
     }
-
-    // now mod and print, then divide divisor
-    do
+    UnityReportUsed = (size_t)status.st_size;
+    if (!UnityMapReport(pending))
     {
-        UNITY_OUTPUT_CHAR((char)('0' + (number / divisor % 10)),index);
-        divisor /= 10;
+        UnityUnmapReport();
+        UnityReportUsed = pending;
+        return 0;
     }
-    while (divisor > 0);
+
+    // whatever was written before the report could be opened goes first
+    memcpy(&UnityReportData[UnityReportUsed], UnityReportBuffer, pending);
+    UnityReportUsed += pending;
+    return 1;
 }
+#endif
 
-//-----------------------------------------------
-/// basically do an itoa using as little ram as possible
-void UnityPrintNumberUnsigned(const _U_UINT number,_US32 index)
+void UnityOpenReport(void)
 {
-    _U_UINT divisor = 1;
-    _U_UINT next_divisor;
+    char filename[256];
 
-    // figure out initial divisor
-    while (number / divisor > 9)
-    {
-        next_divisor = divisor * 10;
-        if (next_divisor > divisor)
-            divisor = next_divisor;
-        else
-            break;
-    }
+    if (UnityReportFile != NULL)
+        return;
+#ifdef UNITY_REPORT_MMAP
+    if (UnityReportFd >= 0)
+        return;
+#endif
 
-    // now mod and print, then divide divisor
-    do
+    filename[0] = '\0';
+    if (UnityReportNamed)
+        strcat(filename, UnityReportName);
+    else
+        strncat(filename, (Unity.TestFile != NULL) ? Unity.TestFile : "unity", sizeof(filename) - sizeof(UNITY_REPORT_EXTENSION));
+    strcat(filename, UNITY_REPORT_EXTENSION);
+#ifdef UNITY_REPORT_MMAP
+    if (UnityOpenMappedReport(filename))
+        return;
+#endif
+    UnityReportFile = fopen(filename, "a");
+    if (UnityReportFile != NULL)
     {
-        UNITY_OUTPUT_CHAR((char)('0' + (number / divisor % 10)), index);
-        divisor /= 10;
+        setvbuf(UnityReportFile, NULL, _IONBF, 0);
+        UnityReportOut = fileno(UnityReportFile);
     }
-    while (divisor > 0);
 }
 
 //-----------------------------------------------
-void UnityPrintNumberHex(const _U_UINT number, const char nibbles_to_print, _US32 index)
+void UnityFlushReport(void)
 {
-    _U_UINT nibble;
-    char nibbles = nibbles_to_print;
-    UNITY_OUTPUT_CHAR('0',index);
-    UNITY_OUTPUT_CHAR('x',index);
+    // a mapped report already holds everything written
+    if ((UnityReportUsed == 0) || (UnityReportData != UnityReportBuffer))
+        return;
 
-    while (nibbles > 0)
+    UnityOpenReport();
+    if (UnityReportData != UnityReportBuffer)
+        return;
+    if (UnityReportFile != NULL)
     {
-        nibble = (number >> (--nibbles << 2)) & 0x0000000F;
-        if (nibble <= 9)
-        {
-            UNITY_OUTPUT_CHAR((char)('0' + nibble),index);
-        }
-        else
-        {
-            UNITY_OUTPUT_CHAR((char)('A' - 10 + nibble), index);
-        }
+        fwrite(UnityReportBuffer, 1, UnityReportUsed, UnityReportFile);
     }
+    UnityReportUsed = 0;
 }
 
 //-----------------------------------------------
-void UnityPrintMask(const _U_UINT mask, const _U_UINT number, _US32 index)
+/// make room for more report output
+static void UnityReportFull(void)
 {
-    _U_UINT current_bit = (_U_UINT)1 << (UNITY_INT_WIDTH - 1);
-    _US32 i;
-    for (i = 0; i < UNITY_INT_WIDTH; i++)
+#ifdef UNITY_REPORT_MMAP
+    if (UnityReportData != UnityReportBuffer)
     {
-        if (current_bit & mask)
-        {
-            if (current_bit & number)
-            {
-                UNITY_OUTPUT_CHAR('1', index);
-            }
-            else
-            {
-                UNITY_OUTPUT_CHAR('0', index);
-            }
-        }
-        else
+        // if the mapping cannot grow, carry on through stdio after what was written
+        if (!UnityMapReport(1))
         {
-            UNITY_OUTPUT_CHAR('X',index);
+            UnityUnmapReport();
+            UnityOpenReport();
         }
-        current_bit = current_bit >> 1;
+        return;
     }
+#endif
+    UnityFlushReport();
 }
 
 //-----------------------------------------------
-#ifdef UNITY_FLOAT_VERBOSE
-void UnityPrintFloat(_UF number, _US32 index)
+void UnityCloseReport(void)
 {
-    char TempBuffer[32];
-    sprintf(TempBuffer, "%.6f", number);
-    UnityPrint(TempBuffer,index);
-}
+    UnityFlushReport();
+#ifdef UNITY_REPORT_MMAP
+    UnityUnmapReport();
 #endif
+    if (UnityReportFile != NULL)
+    {
+        fclose(UnityReportFile);
+        UnityReportFile = NULL;
+    }
+    UnityReportOut = -1;
+    UnityReportNamed = 0;
+}
 
 //-----------------------------------------------
-
-void UnityPrintFail(void)
+/// send the report output that follows to the report of the given test file; 1 if that closed another
+static int UnitySwitchReport(const char* file)
 {
-    UnityPrint("FAIL",1);
-}
+    if (file == NULL)
+        file = "unity";
+    if (UnityReportNamed && (strcmp(UnityReportName, file) == 0))
+        return 0;
 
-void UnityPrintOk(void)
-{
-    UnityPrint("OK",1);
+    UnityCloseReport();
+    UnityReportName[0] = '\0';
+    strncat(UnityReportName, file, sizeof(UnityReportName) - 1);
+    UnityReportNamed = 1;
+#ifdef UNITY_SUPPORT_CACHE
+    UnityCacheSegment(UnityReportName);
+#endif
+    // opened now so the crash flush has somewhere to write what follows
+    UnityOpenReport();
+    return 1;
 }
 
+#ifdef UNITY_SUPPORT_FORK
 //-----------------------------------------------
-void UnityTestResultsBegin(const char* file, const UNITY_LINE_TYPE line, _US32 index)
+/// let go of the report without writing to it, as a forked child must
+static void UnityDropReport(void)
 {
-    if (index==1) {
-        UnityPrint(file, index);
-        UNITY_OUTPUT_CHAR(':', index);
-        UnityPrintNumber(line, index);
-        UNITY_OUTPUT_CHAR(':', index);
-        UnityPrint(Unity.CurrentTestName, index);
-        UNITY_OUTPUT_CHAR(':', index);
+    UnityReportUsed = 0;
+#ifdef UNITY_REPORT_MMAP
+    if (UnityReportFd >= 0)
+    {
+        if (UnityReportData != UnityReportBuffer)
+            munmap(UnityReportData, UnityReportSize);
+        close(UnityReportFd);
+        UnityReportFd = -1;
+        UnityReportData = UnityReportBuffer;
+        UnityReportSize = sizeof(UnityReportBuffer);
+        UnityReportBase = 0;
     }
-    else{
-        
-        UNITY_OUTPUT_CHAR('{', index);
-        UNITY_OUTPUT_CHAR('\n', index);
-        UnityPrint("\"filename\":", index);
-        UNITY_OUTPUT_CHAR('\"',index);
-        UnityPrint(file,index);
-        UNITY_OUTPUT_CHAR('\"',index);
-        UNITY_OUTPUT_CHAR(',',index);
-        UNITY_OUTPUT_CHAR('\n',index);
-        
-        UnityPrint("\"functionn_name\":",index);
-        UNITY_OUTPUT_CHAR('\"',index);
-        UnityPrint(Unity.CurrentTestName,index);
-        UNITY_OUTPUT_CHAR('\"',index);
-        UNITY_OUTPUT_CHAR(',',index);
-        UNITY_OUTPUT_CHAR('\n',index);
-        
-        UnityPrint("\"linenumber\":",index);
-        UNITY_OUTPUT_CHAR('\"',index);
-        UnityPrintNumber(Unity.CurrentTestLineNumber,index);
-        UNITY_OUTPUT_CHAR('\"',index);
-        UNITY_OUTPUT_CHAR(',',index);
-        UNITY_OUTPUT_CHAR('\n',index);
+#endif
+    if (UnityReportFile != NULL)
+    {
+        // it is unbuffered, so closing it writes nothing
+        fclose(UnityReportFile);
+        UnityReportFile = NULL;
     }
-        
+    UnityReportOut = -1;
+    UnityReportNamed = 0;
+}
+#endif
+
+//-----------------------------------------------
+#ifndef UNITY_EXCLUDE_CRASH_FLUSH
+// cleared in forked children, whose report and JUnit files are the parent's
+static int UnityFlushAtExit = 1;
 
+static void UnityExitFlush(void)
+{
+    if (!UnityFlushAtExit)
+        return;
+    UnityFlushResults();
+    UnityCloseReport();
+    UnityCloseJUnit();
 }
 
+// A test that aborts or faults never reaches UnityEnd().  Only write(2) is safe
+// in a signal handler, so the crash flush writes out the report output that is
+// already formatted and then hands the signal on to whatever handled it before
+// UnityBegin().  While it is installed every result is formatted as its test
+// ends rather than queued in the arena, so that is every finished test; only
+// the write waits for the buffer to fill.  The JUnit file and stdout are left
+// as they are.
+static const int UnityCrashSignals[] =
+{
+    SIGABRT, SIGSEGV, SIGFPE, SIGILL,
+#ifdef SIGBUS
+    SIGBUS,
+#endif
+};
+#define UNITY_CRASH_SIGNALS (sizeof(UnityCrashSignals) / sizeof(UnityCrashSignals[0]))
+
+static struct sigaction UnityCrashPrevious[UNITY_CRASH_SIGNALS];
+static int UnityCrashInstalled = 0;
+static volatile sig_atomic_t UnityCrashing = 0;
+
 //-----------------------------------------------
-void UnityTestResultsFailBegin(const UNITY_LINE_TYPE line, _US32 index)
+/// write out the formatted report, with nothing but async-signal-safe calls
+static void UnityCrashWrite(void)
 {
-    UnityTestResultsBegin(Unity.TestFile, line, index);
-    if (index==1) {
-        UnityPrint("FAIL:", index);
+    const char* data = UnityReportBuffer;
+    size_t left = UnityReportUsed;
+    const int error = errno;
+    ssize_t written;
+
+#ifdef UNITY_REPORT_MMAP
+    // a mapped report is in the file already, followed by the zeros to trim
+    if (UnityReportData != UnityReportBuffer)
+    {
+        UnityTrimReport();
+        return;
     }
-    else{
-        UnityPrint("\"IGNORE\":\"NOT IGNORED\"",index);
-        UNITY_OUTPUT_CHAR(',',index);
-        UNITY_OUTPUT_CHAR('\n',index);
-        UnityPrint("\"result\":\"Fail\"",index);
-        UNITY_OUTPUT_CHAR(',',index);
-        UNITY_OUTPUT_CHAR('\n',index);
+#endif
+    if (UnityReportOut < 0)
+        return;
+    while (left > 0)
+    {
+        written = write(UnityReportOut, data, left);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+        data += written;
+        left -= (size_t)written;
     }
-    
+    UnityReportUsed = 0;
+    errno = error;
 }
 
 //-----------------------------------------------
-void UnityConcludeTest()
+static void UnityCrashFlush(int sig, siginfo_t* info, void* context)
 {
-    _US32 index;
-    if (Unity.CurrentTestIgnored)
+    const struct sigaction* previous = NULL;
+    size_t i;
+
+    for (i = 0; i < UNITY_CRASH_SIGNALS; i++)
     {
-        Unity.TestIgnores++;
+        if (UnityCrashSignals[i] == sig)
+            previous = &UnityCrashPrevious[i];
     }
-    else if (!Unity.CurrentTestFailed)
+    // a second fault, in here or in a handler called from here, writes nothing more
+    if (!UnityCrashing)
     {
-        for (index=0; index<2; index++) {
-            UnityTestResultsBegin(Unity.TestFile, Unity.CurrentTestLineNumber, index);
-            if (index) {
-                UnityPrint("PASS",index);
-            }
-            else{
-                UnityPrint("\"ignored\":\"NO\"",index);
-                UNITY_OUTPUT_CHAR(',',index);
-                UNITY_OUTPUT_CHAR('\n',index);
-                UnityPrint("\"result\":\"PASS\"",index);
-                UNITY_OUTPUT_CHAR(',',index);
-                UNITY_OUTPUT_CHAR('\n',index);
-                UnityPrint("\"message\":\"\"",index);
-                UNITY_OUTPUT_CHAR('\n',index);
-                UNITY_OUTPUT_CHAR('}',index);
-            }
-        }
+        UnityCrashing = 1;
+        UnityFlushAtExit = 0;
+        UnityCrashWrite();
+    }
+    if (previous == NULL)
+        return;
 
-        
-        UNITY_PRINT_EOL;
+    if ((previous->sa_flags & SA_SIGINFO) != 0)
+    {
+        previous->sa_sigaction(sig, info, context);
+        return;
     }
-    else
+    if ((previous->sa_handler != SIG_DFL) && (previous->sa_handler != SIG_IGN))
     {
-        Unity.TestFailures++;
+        previous->sa_handler(sig);
+        return;
     }
-
-    Unity.CurrentTestFailed = 0;
-    Unity.CurrentTestIgnored = 0;
+    // a fault comes straight back once this returns, and a raised signal is raised again
+    sigaction(sig, previous, NULL);
+    if (previous->sa_handler == SIG_DFL)
+        raise(sig);
 }
 
 //-----------------------------------------------
-void UnityAddMsgIfSpecified(const char* msg, _US32 index)
+static void UnityInstallCrashFlush(void)
 {
-    if (msg)
+    static int registered = 0;
+    struct sigaction action;
+    size_t i;
+
+    if (!UnityCrashInstalled)
+    {
+        memset(&action, 0, sizeof(action));
+        action.sa_sigaction = UnityCrashFlush;
+        action.sa_flags = SA_SIGINFO;
+#ifdef SA_ONSTACK
+        // on the alternate stack, if there is one, so a stack overflow still gets here
+        action.sa_flags |= SA_ONSTACK;
+#endif
+        sigemptyset(&action.sa_mask);
+        for (i = 0; i < UNITY_CRASH_SIGNALS; i++)
+        {
+            sigaction(UnityCrashSignals[i], &action, &UnityCrashPrevious[i]);
+        }
+        UnityCrashInstalled = 1;
+        UnityCrashing = 0;
+    }
+    if (!registered)
     {
-        UnityPrint(UnityStrSpacer,index);
-        UnityPrint(msg,index);
+        atexit(UnityExitFlush);
+        registered = 1;
     }
 }
 
 //-----------------------------------------------
-void UnityPrintExpectedAndActualStrings(const char* expected, const char* actual)
+/// put back the handlers UnityInstallCrashFlush() found
+static void UnityRemoveCrashFlush(void)
 {
-    _US32 index;
-    
-    if (expected != NULL)
+    size_t i;
+
+    if (!UnityCrashInstalled)
+        return;
+    for (i = 0; i < UNITY_CRASH_SIGNALS; i++)
     {
-        index=0;
-        UnityPrint(UnityStrExpected[index],index);
-        UNITY_OUTPUT_CHAR('\'',0);
-        UnityPrint(expected,index);
-        index=1;
-        UnityPrint(expected,index);
-        UNITY_OUTPUT_CHAR('\'',0);
+        sigaction(UnityCrashSignals[i], &UnityCrashPrevious[i], NULL);
+    }
+    UnityCrashInstalled = 0;
+}
+#endif
+
+//-----------------------------------------------
+int put_char(int a, _US32 index){
+#ifdef UNITY_SUPPORT_CACHE
+    const char c = (char)a;
+    UNITY_CACHE_KEEP(&c, 1, index);
+#endif
+    if (index == UNITY_CHANNEL_CONSOLE) {
+        putchar(a);
     }
     else
     {
-      UnityPrint(UnityStrNull,1);
-      UnityPrint(UnityStrNull,0);
-    }
-    for (index=0; index<2; index++) {
-        UnityPrint(UnityStrWas,index);
-        if (actual != NULL)
-        {
-            UNITY_OUTPUT_CHAR('\'',index);
-            UnityPrint(actual,index);
-            UNITY_OUTPUT_CHAR('\'',index);
-        }
-        else
-        {
-            UnityPrint(UnityStrNull,index);          
-        }
+        if (UnityReportUsed == UnityReportSize)
+            UnityReportFull();
+        UnityReportData[UnityReportUsed++] = (char)a;
     }
-    UNITY_OUTPUT_CHAR('\"',0);
-    UNITY_OUTPUT_CHAR('\n',0);
-    UNITY_OUTPUT_CHAR('}',0);
-
+    return 0;
 }
 
 //-----------------------------------------------
-// Assertion & Control Helpers
-//-----------------------------------------------
-
-int UnityCheckArraysForNull(const void* expected, const void* actual, const UNITY_LINE_TYPE lineNumber, const char* msg)
+int put_span(const char* text, _UU32 length, _US32 index)
 {
-    
-    _US32 index;
-    
-    //return true if they are both NULL
-    if ((expected == NULL) && (actual == NULL))
-        return 1;
-        
-    //throw error if just expected is NULL
-    if (expected == NULL)
+    size_t room;
+
+    UNITY_CACHE_KEEP(text, length, index);
+    if (index == UNITY_CHANNEL_CONSOLE)
     {
-        for (index=0; index<2; index++) {
-            UnityTestResultsFailBegin(lineNumber,index);
-            UnityPrint(UnityStrNullPointerForExpected,index);
-            UnityAddMsgIfSpecified(msg,index);
-        }
-        UNITY_FAIL_AND_BAIL;
+        fwrite(text, 1, length, stdout);
+        return 0;
     }
 
-    //throw error if just actual is NULL
-    if (actual == NULL)
+    while (length > 0)
     {
-        for (index=0; index<2; index++) {
-            UnityTestResultsFailBegin(lineNumber,index);
-            UnityPrint(UnityStrNullPointerForActual,index);
-            UnityAddMsgIfSpecified(msg,index);
-        }
-        UNITY_FAIL_AND_BAIL;
-
+        if (UnityReportUsed == UnityReportSize)
+            UnityReportFull();
+        room = UnityReportSize - UnityReportUsed;
+        if (room > length)
+            room = length;
+        memcpy(&UnityReportData[UnityReportUsed], text, room);
+        UnityReportUsed += room;
+        text += room;
+        length -= (_UU32)room;
     }
-    
-    //return false if neither is NULL
     return 0;
 }
-
 //-----------------------------------------------
-// Assertion Functions
+// Pretty Printers & Test Result Output Handlers
 //-----------------------------------------------
 
-void UnityAssertBits(const _U_SINT mask,
-                     const _U_SINT expected,
-                     const _U_SINT actual,
-                     const char* msg,
-                     const UNITY_LINE_TYPE lineNumber)
+/// write text that needs no escaping, such as a formatted number, in one go where the output allows it
+static void UnityPrintSpan(const char* text, const _UU32 length, _US32 index)
 {
-    UNITY_SKIP_EXECUTION;
-    _US32 index;
-    if ((mask & expected) != (mask & actual))
+#ifdef UNITY_OUTPUT_SPAN
+    UNITY_OUTPUT_SPAN(text, length, index);
+#else
+    _UU32 i;
+    for (i = 0; i < length; i++)
     {
-        for (index=0; index<2; index++) {
-            UnityTestResultsFailBegin(lineNumber,index);
-            UnityPrint(UnityStrExpected[index],index);
-            UnityPrintMask(mask, expected,index);
-            UnityPrint(UnityStrWas,index);
-            UnityPrintMask(mask, actual,index);
-            
-            UnityAddMsgIfSpecified(msg,index);
-        }
-        UNITY_OUTPUT_CHAR('\"',0);
-        UNITY_OUTPUT_CHAR('\n',0);
-        UNITY_OUTPUT_CHAR('}',0);
-        UNITY_FAIL_AND_BAIL;
+        UNITY_OUTPUT_CHAR(text[i], index);
     }
+#endif
 }
 
 //-----------------------------------------------
-void UnityAssertEqualNumber(const _U_SINT expected,
-                            const _U_SINT actual,
-                            const char* msg,
-                            const UNITY_LINE_TYPE lineNumber,
+void UnityPrint(const char* string, _US32 index)
+{
+    const char* pch = string;
+    const char* run;
+
+    if (pch != NULL)
+    {
+        while (*pch)
+        {
+            // printable characters are written a run at a time
+            run = pch;
+            while ((*pch <= 126) && (*pch >= 32))
+            {
+                pch++;
+            }
+            if (pch != run)
+            {
+                UnityPrintSpan(run, (_UU32)(pch - run), index);
+            }
+
+            if (*pch == 0)
+            {
+                break;
+            }
+            //write escaped carriage returns
+            else if (*pch == 13)
+            {
+                UNITY_OUTPUT_CHAR('\\', index);
+                UNITY_OUTPUT_CHAR('r', index);
+            }
+            //write escaped line feeds
+            else if (*pch == 10)
+            {
+                UNITY_OUTPUT_CHAR('\\',index);
+                UNITY_OUTPUT_CHAR('n',index);
+            }
+            // unprintable characters are shown as codes
+            else
+            {
+                UNITY_OUTPUT_CHAR('\\',index);
+                UnityPrintNumberHex((_U_SINT)*pch, 2, index);
+            }
+            pch++;
+        }
+    }
+}
+
+//-----------------------------------------------
+_UU32 UnityFormatNumberByStyle(char* buffer, const _U_SINT number, const UNITY_DISPLAY_STYLE_T style)
+{
+    if ((style & UNITY_DISPLAY_RANGE_INT) == UNITY_DISPLAY_RANGE_INT)
+    {
+        return UnityFormatNumber(buffer, number);
+    }
+    else if ((style & UNITY_DISPLAY_RANGE_UINT) == UNITY_DISPLAY_RANGE_UINT)
+    {
+        return UnityFormatNumberUnsigned(buffer, (_U_UINT)number  &  UnitySizeMask[((_U_UINT)style & (_U_UINT)0x0F) - 1]);
+    }
+    else
+    {
+        return UnityFormatNumberHex(buffer, (_U_UINT)number, (char)((style & 0x000F) << 1));
+    }
+}
+
+//-----------------------------------------------
+_UU32 UnityFormatNumber(char* buffer, const _U_SINT number)
+{
+    // negate in unsigned space so the most negative value survives
+    if (number < 0)
+    {
+        buffer[0] = '-';
+        return 1 + UnityFormatNumberUnsigned(buffer + 1, (_U_UINT)0 - (_U_UINT)number);
+    }
+    return UnityFormatNumberUnsigned(buffer, (_U_UINT)number);
+}
+
+//-----------------------------------------------
+// "00" to "99", so numbers are formatted two digits per division
+static const char UnityDigitPairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const char UnityHexDigits[17] = "0123456789ABCDEF";
+
+//-----------------------------------------------
+_UU32 UnityFormatNumberUnsigned(char* buffer, const _U_UINT number)
+{
+    char digits[24];
+    char* first = &digits[sizeof(digits)];
+    _U_UINT remaining = number;
+    _UU32 pair, count;
+
+    // fill from the right, two digits at a time
+    while (remaining >= 100)
+    {
+        pair = (_UU32)(remaining % 100) * 2;
+        remaining /= 100;
+        *--first = UnityDigitPairs[pair + 1];
+        *--first = UnityDigitPairs[pair];
+    }
+    if (remaining >= 10)
+    {
+        pair = (_UU32)remaining * 2;
+        *--first = UnityDigitPairs[pair + 1];
+        *--first = UnityDigitPairs[pair];
+    }
+    else
+    {
+        *--first = (char)('0' + remaining);
+    }
+
+    count = (_UU32)(&digits[sizeof(digits)] - first);
+    memcpy(buffer, first, count);
+    buffer[count] = '\0';
+    return count;
+}
+
+//-----------------------------------------------
+_UU32 UnityFormatNumberHex(char* buffer, const _U_UINT number, const char nibbles_to_print)
+{
+    _UU32 nibbles = (_UU32)nibbles_to_print;
+    _UU32 i;
+
+    buffer[0] = '0';
+    buffer[1] = 'x';
+    for (i = 0; i < nibbles; i++)
+    {
+        buffer[2 + i] = UnityHexDigits[(number >> ((nibbles - 1 - i) << 2)) & 0x0F];
+    }
+    buffer[2 + nibbles] = '\0';
+    return 2 + nibbles;
+}
+
+//-----------------------------------------------
+_UU32 UnityFormatMask(char* buffer, const _U_UINT mask, const _U_UINT number)
+{
+    _UU32 i, shift;
+
+    for (i = 0; i < UNITY_INT_WIDTH; i++)
+    {
+        shift = UNITY_INT_WIDTH - 1 - i;
+        buffer[i] = (((mask >> shift) & 1) != 0) ? (char)('0' + ((number >> shift) & 1)) : 'X';
+    }
+    buffer[i] = '\0';
+    return i;
+}
+
+//-----------------------------------------------
+void UnityPrintNumberByStyle(const _U_SINT number, const UNITY_DISPLAY_STYLE_T style, _US32 index)
+{
+    char buffer[UNITY_FIELD_TEXT_SIZE];
+    UnityPrintSpan(buffer, UnityFormatNumberByStyle(buffer, number, style), index);
+}
+
+//-----------------------------------------------
+void UnityPrintNumber(const _U_SINT number, _US32 index)
+{
+    char buffer[UNITY_FIELD_TEXT_SIZE];
+    UnityPrintSpan(buffer, UnityFormatNumber(buffer, number), index);
+}
+
+//-----------------------------------------------
+void UnityPrintNumberUnsigned(const _U_UINT number, _US32 index)
+{
+    char buffer[UNITY_FIELD_TEXT_SIZE];
+    UnityPrintSpan(buffer, UnityFormatNumberUnsigned(buffer, number), index);
+}
+
+//-----------------------------------------------
+void UnityPrintNumberHex(const _U_UINT number, const char nibbles_to_print, _US32 index)
+{
+    char buffer[UNITY_FIELD_TEXT_SIZE];
+    UnityPrintSpan(buffer, UnityFormatNumberHex(buffer, number, nibbles_to_print), index);
+}
+
+//-----------------------------------------------
+void UnityPrintMask(const _U_UINT mask, const _U_UINT number, _US32 index)
+{
+    char buffer[UNITY_FIELD_TEXT_SIZE];
+    UnityPrintSpan(buffer, UnityFormatMask(buffer, mask, number), index);
+}
+
+//-----------------------------------------------
+/// print a string to the report as the inside of a JSON string: quotes, backslashes and control characters escaped
+static void UnityPrintJson(const char* string)
+{
+    const _US32 index = UNITY_CHANNEL_JSON;
+    const unsigned char* pch = (const unsigned char*)string;
+    const unsigned char* run;
+
+    if (pch == NULL)
+        return;
+
+    while (*pch)
+    {
+        run = pch;
+        while ((*pch >= 32) && (*pch != '"') && (*pch != '\\'))
+        {
+            pch++;
+        }
+        if (pch != run)
+        {
+            UnityPrintSpan((const char*)run, (_UU32)(pch - run), index);
+        }
+
+        if (*pch == 0)
+            break;
+
+        UNITY_OUTPUT_CHAR('\\', index);
+        switch (*pch)
+        {
+            case '"':
+            case '\\':
+                UNITY_OUTPUT_CHAR(*pch, index);
+                break;
+            case 10:
+                UNITY_OUTPUT_CHAR('n', index);
+                break;
+            case 13:
+                UNITY_OUTPUT_CHAR('r', index);
+                break;
+            case 9:
+                UNITY_OUTPUT_CHAR('t', index);
+                break;
+            default:
+                UnityPrintSpan("u00", 3, index);
+                UNITY_OUTPUT_CHAR(UnityHexDigits[*pch >> 4], index);
+                UNITY_OUTPUT_CHAR(UnityHexDigits[*pch & 0x0F], index);
+                break;
+        }
+        pch++;
+    }
+}
+
+//-----------------------------------------------
+#ifdef UNITY_FLOAT_VERBOSE
+_UU32 UnityFormatFloat(char* buffer, const _UF number)
+{
+    return (_UU32)sprintf(buffer, "%.6f", number);
+}
+
+void UnityPrintFloat(_UF number, _US32 index)
+{
+    char TempBuffer[UNITY_FIELD_TEXT_SIZE];
+    UnityFormatFloat(TempBuffer, number);
+    UnityPrint(TempBuffer,index);
+}
+#endif
+
+//-----------------------------------------------
+
+void UnityPrintFail(void)
+{
+    UnityPrint("FAIL",UNITY_CHANNEL_CONSOLE);
+}
+
+void UnityPrintOk(void)
+{
+    UnityPrint("OK",UNITY_CHANNEL_CONSOLE);
+}
+
+//-----------------------------------------------
+// Timing
+//-----------------------------------------------
+
+#ifdef UNITY_POSIX_CLOCK
+/// nanoseconds from one of the POSIX clocks
+static unsigned long long UnityClockNs(const clockid_t clock)
+{
+    struct timespec now;
+
+    if (clock_gettime(clock, &now) != 0)
+        return 0;
+    return ((unsigned long long)now.tv_sec * 1000000000ULL) + (unsigned long long)now.tv_nsec;
+}
+#endif
+
+#ifdef UNITY_SUPPORT_TIMING
+//-----------------------------------------------
+static _UU32 UnityFormatTime(char* buffer, const _UT number)
+{
+    char digits[24];
+    _UT remaining = number;
+    _UU32 count = 0;
+    _UU32 i;
+
+    do
+    {
+        digits[count++] = (char)('0' + (remaining % 10));
+        remaining /= 10;
+    }
+    while (remaining > 0);
+
+    for (i = 0; i < count; i++)
+    {
+        buffer[i] = digits[count - i - 1];
+    }
+    buffer[count] = '\0';
+    return count;
+}
+
+//-----------------------------------------------
+static void UnityPrintTime(const _UT number, _US32 index)
+{
+    char buffer[24];
+    UnityFormatTime(buffer, number);
+    UnityPrint(buffer, index);
+}
+
+//-----------------------------------------------
+/// print a count of thousandths as a number with three decimals
+static void UnityPrintThousandths(const _UT number, _US32 index)
+{
+    char buffer[24];
+    const _UT fraction = number % 1000;
+
+    UnityPrintTime(number / 1000, index);
+    buffer[0] = '.';
+    buffer[1] = (char)('0' + (fraction / 100));
+    buffer[2] = (char)('0' + ((fraction / 10) % 10));
+    buffer[3] = (char)('0' + (fraction % 10));
+    buffer[4] = '\0';
+    UnityPrint(buffer, index);
+}
+
+//-----------------------------------------------
+static void UnityPrintMilliseconds(const _UT number, _US32 index)
+{
+    UnityPrintThousandths(number / 1000, index);
+    UnityPrint(" ms", index);
+}
+
+//-----------------------------------------------
+static _UT UnityTimingTotal(const struct _UnityTiming* timing)
+{
+    return timing->Phase[UNITY_PHASE_SETUP] + timing->Phase[UNITY_PHASE_TEST] + timing->Phase[UNITY_PHASE_TEARDOWN];
+}
+
+//-----------------------------------------------
+static void UnityTimingBegin(void)
+{
+    memset(&Unity.CurrentTiming, 0, sizeof(Unity.CurrentTiming));
+    Unity.CurrentPhase = UNITY_PHASE_SETUP;
+    Unity.CpuStarted = UNITY_CPU_CLOCK_NS();
+    Unity.PhaseStarted = UNITY_CLOCK_NS();
+}
+
+//-----------------------------------------------
+/// charge the time since the last switch to the phase that was running
+static void UnityTimingSwitch(const UNITY_PHASE_T phase)
+{
+    const _UT now = UNITY_CLOCK_NS();
+
+    Unity.CurrentTiming.Phase[Unity.CurrentPhase] += now - Unity.PhaseStarted;
+    Unity.CurrentPhase = phase;
+    Unity.PhaseStarted = now;
+}
+
+//-----------------------------------------------
+static void UnityTimingEnd(void)
+{
+    UnityTimingSwitch(Unity.CurrentPhase);
+    Unity.CurrentTiming.Cpu = UNITY_CPU_CLOCK_NS() - Unity.CpuStarted;
+}
+
+#if (UNITY_SLOWEST_TESTS > 0)
+// The slowest reported tests, longest first
+static struct _UnityResult UnitySlowestResults[UNITY_SLOWEST_TESTS];
+static _UU32 UnitySlowestCount = 0;
+
+//-----------------------------------------------
+static void UnityTrackSlowest(const struct _UnityResult* result)
+{
+    const _UT total = UnityTimingTotal(&result->Timing);
+    _UU32 i = UnitySlowestCount;
+
+    // benchmarks are slow on purpose
+    if (result->Benchmark.Samples > 0)
+        return;
+    if ((i == UNITY_SLOWEST_TESTS) && (total <= UnityTimingTotal(&UnitySlowestResults[i - 1].Timing)))
+        return;
+    if (i < UNITY_SLOWEST_TESTS)
+        UnitySlowestCount++;
+    else
+        i--;
+
+    // only the name, line and timing are kept; the fields may not outlive the report
+    while ((i > 0) && (total > UnityTimingTotal(&UnitySlowestResults[i - 1].Timing)))
+    {
+        UnitySlowestResults[i] = UnitySlowestResults[i - 1];
+        i--;
+    }
+    UnitySlowestResults[i] = *result;
+    UnitySlowestResults[i].FieldCount = 0;
+    UnitySlowestResults[i].Fields = NULL;
+}
+
+//-----------------------------------------------
+static void UnityPrintSlowest(void)
+{
+    const _US32 index = UNITY_CHANNEL_CONSOLE;
+    _UU32 i;
+
+    if (UnitySlowestCount == 0)
+        return;
+
+    UnityPrint("Slowest Tests:", index);
+    UNITY_PRINT_EOL;
+    for (i = 0; i < UnitySlowestCount; i++)
+    {
+        UnityPrint(UnitySlowestResults[i].File, index);
+        UnityPrint(":", index);
+        UnityPrintNumber(UnitySlowestResults[i].TestLineNumber, index);
+        UnityPrint(":", index);
+        UnityPrint(UnitySlowestResults[i].TestName, index);
+        UnityPrint(": ", index);
+        UnityPrintMilliseconds(UnityTimingTotal(&UnitySlowestResults[i].Timing), index);
+        UnityPrint(" (cpu ", index);
+        UnityPrintMilliseconds(UnitySlowestResults[i].Timing.Cpu, index);
+        UnityPrint(")", index);
+        UNITY_PRINT_EOL;
+    }
+}
+#endif
+
+// Benchmarks reported this run, compared with the baseline by UnityEnd
+struct _UnityBaselineEntry
+{
+    const char* File;
+    const char* TestName;
+    UNITY_LINE_TYPE LineNumber;
+    _UT Median;
+    _UT Stddev;
+    _UT BaselineMedian;
+    _UT BaselineStddev;
+    int Found;
+};
+
+static struct _UnityBaselineEntry UnityBaselineEntries[UNITY_BASELINE_MAX_BENCHMARKS];
+static _UU32 UnityBaselineCount = 0;
+
+//-----------------------------------------------
+static void UnityTrackBenchmark(const struct _UnityResult* result)
+{
+    struct _UnityBaselineEntry* entry;
+
+    if ((result->Benchmark.Samples == 0) || (UnityBaselineCount == UNITY_BASELINE_MAX_BENCHMARKS))
+        return;
+
+    entry = &UnityBaselineEntries[UnityBaselineCount++];
+    memset(entry, 0, sizeof(*entry));
+    entry->File = result->File;
+    entry->TestName = result->TestName;
+    entry->LineNumber = result->TestLineNumber;
+    entry->Median = result->Benchmark.Median;
+    entry->Stddev = result->Benchmark.Stddev;
+}
+#endif
+
+//-----------------------------------------------
+// Result Sinks
+//-----------------------------------------------
+
+static const struct _UnitySink* UnitySinks[UNITY_MAX_SINKS];
+static _UU32 UnitySinkCount = 0;
+
+void UnityAddSink(const struct _UnitySink* sink)
+{
+    if (UnitySinkCount < UNITY_MAX_SINKS)
+    {
+        UnitySinks[UnitySinkCount++] = sink;
+    }
+}
+
+//-----------------------------------------------
+void UnityClearSinks(void)
+{
+    UnitySinkCount = 0;
+}
+
+//-----------------------------------------------
+static const char* UnityFormatField(const struct _UnityField* field, char* buffer)
+{
+    switch (field->Type)
+    {
+        case UNITY_VALUE_NUMBER:
+            UnityFormatNumberByStyle(buffer, field->Number, field->Style);
+            return buffer;
+        case UNITY_VALUE_MASK:
+            UnityFormatMask(buffer, (_U_UINT)field->Mask, (_U_UINT)field->Number);
+            return buffer;
+#ifdef UNITY_FLOAT_VERBOSE
+        case UNITY_VALUE_FLOAT:
+            UnityFormatFloat(buffer, field->Float);
+            return buffer;
+#endif
+        default:
+            return (field->String != NULL) ? field->String : UnityStrNull;
+    }
+}
+
+//-----------------------------------------------
+/// format every field once, then fan the result out to all sinks
+void UnityReportResult(const struct _UnityResult* result)
+{
+    char buffers[UNITY_RESULT_MAX_FIELDS][UNITY_FIELD_TEXT_SIZE];
+    const char* texts[UNITY_RESULT_MAX_FIELDS];
+    _UU32 i, s;
+    int formatted = 0;
+
+    // unless every sink records raw values
+    for (s = 0; s < UnitySinkCount; s++)
+    {
+        if ((UnitySinks[s]->Field != NULL) && !UnitySinks[s]->RawFields)
+            formatted = 1;
+    }
+    for (i = 0; i < result->FieldCount; i++)
+    {
+        texts[i] = formatted ? UnityFormatField(&result->Fields[i], buffers[i]) : NULL;
+    }
+
+    for (s = 0; s < UnitySinkCount; s++)
+    {
+        const struct _UnitySink* sink = UnitySinks[s];
+        if (sink->BeginTest != NULL)
+            sink->BeginTest(result);
+        if (sink->Field != NULL)
+        {
+            for (i = 0; i < result->FieldCount; i++)
+            {
+                sink->Field(&result->Fields[i], sink->RawFields ? NULL : texts[i]);
+            }
+        }
+        if (sink->EndTest != NULL)
+            sink->EndTest(result);
+    }
+    UnityTrackHistory(result);
+#ifdef UNITY_SUPPORT_TIMING
+#if (UNITY_SLOWEST_TESTS > 0)
+    UnityTrackSlowest(result);
+#endif
+    UnityTrackBenchmark(result);
+#endif
+}
+
+//-----------------------------------------------
+/// what goes ahead of a field's value; a detail is only set off by a space
+static const char* UnityFieldLabel(const UNITY_FIELD_T kind)
+{
+    switch (kind)
+    {
+        case UNITY_FIELD_ELEMENT:  return UnityStrElement;
+        case UNITY_FIELD_BYTE:     return UnityStrByte;
+        case UNITY_FIELD_DELTA:    return UnityStrDelta;
+        case UNITY_FIELD_EXPECTED: return UnityStrExpected;
+        case UNITY_FIELD_ACTUAL:   return UnityStrWas;
+        case UNITY_FIELD_MESSAGE:  return UnityStrSpacer;
+        default:                   return NULL;
+    }
+}
+
+//-----------------------------------------------
+/// console and JSON sinks share the human readable rendering of a field; first drops the
+/// space it starts with, which follows "FAIL:" on the console but not the JSON message key
+static void UnityPrintField(const struct _UnityField* field, const char* text, const _US32 index, const int first)
+{
+    const char* label = UnityFieldLabel(field->Kind);
+
+    if (label != NULL)
+    {
+        UnityPrint((first && (label[0] == ' ')) ? &label[1] : label, index);
+    }
+    else if (first)
+    {
+        text = (text[0] == ' ') ? &text[1] : text;
+    }
+    else if (text[0] != ' ')
+    {
+        UNITY_OUTPUT_CHAR(' ', index);
+    }
+
+    if ((field->Type == UNITY_VALUE_STRING) && (field->String != NULL))
+    {
+        UNITY_OUTPUT_CHAR('\'', index);
+    }
+    // the report gets the text itself, escaped for JSON, rather than its console rendering
+    if (index == UNITY_CHANNEL_JSON)
+    {
+        UnityPrintJson(text);
+    }
+    else
+    {
+        UnityPrint(text, index);
+    }
+    if ((field->Type == UNITY_VALUE_STRING) && (field->String != NULL))
+    {
+        UNITY_OUTPUT_CHAR('\'', index);
+    }
+}
+
+//-----------------------------------------------
+static void UnityConsoleBeginTest(const struct _UnityResult* result)
+{
+    const _US32 index = UNITY_CHANNEL_CONSOLE;
+
+    UnityPrint(result->File, index);
+    UNITY_OUTPUT_CHAR(':', index);
+    UnityPrintNumber(result->LineNumber, index);
+    UNITY_OUTPUT_CHAR(':', index);
+    UnityPrint(result->TestName, index);
+    UNITY_OUTPUT_CHAR(':', index);
+    switch (result->Status)
+    {
+        case UNITY_RESULT_PASS:    UnityPrint("PASS", index);   break;
+        case UNITY_RESULT_FAIL:    UnityPrint("FAIL", index);   break;
+        case UNITY_RESULT_IGNORE:  UnityPrint("IGNORE", index); break;
+        // the console keeps to PASS/FAIL/IGNORE; the message says it timed out
+        case UNITY_RESULT_TIMEOUT: UnityPrint("FAIL", index);   break;
+    }
+    if (result->FieldCount > 0)
+    {
+        UNITY_OUTPUT_CHAR(':', index);
+    }
+}
+
+static void UnityConsoleField(const struct _UnityField* field, const char* text)
+{
+    UnityPrintField(field, text, UNITY_CHANNEL_CONSOLE, 0);
+}
+
+static void UnityConsoleEndTest(const struct _UnityResult* result)
+{
+#ifdef UNITY_SUPPORT_TIMING
+    const _US32 index = UNITY_CHANNEL_CONSOLE;
+    const struct _UnityBenchmark* benchmark = &result->Benchmark;
+
+    if (benchmark->Samples > 0)
+    {
+        UnityPrint(": ", index);
+        UnityPrintThousandths(benchmark->Median, index);
+        UnityPrint(" ns/iter (min ", index);
+        UnityPrintThousandths(benchmark->Min, index);
+        UnityPrint(", p99 ", index);
+        UnityPrintThousandths(benchmark->P99, index);
+        UnityPrint(", stddev ", index);
+        UnityPrintThousandths(benchmark->Stddev, index);
+        UnityPrint(", ", index);
+        UnityPrintNumberUnsigned(benchmark->Samples, index);
+        UnityPrint(" x ", index);
+        UnityPrintNumberUnsigned(benchmark->Iterations, index);
+        UnityPrint(")", index);
+    }
+#else
+    (void)result;
+#endif
+    UNITY_OUTPUT_CHAR('\n', UNITY_CHANNEL_CONSOLE);
+}
+
+const struct _UnitySink UnitySinkConsole = { UnityConsoleBeginTest, UnityConsoleField, UnityConsoleEndTest, 0 };
+
+// set at the start of every record, until its message gets its first field
+static int UnityJsonFirstField = 0;
+
+#ifdef UNITY_REPORT_JSON_LINES
+//-----------------------------------------------
+// With UNITY_REPORT_JSON_LINES the report holds one JSON object per line, always
+// with the same keys in the same order, so it can be parsed as it is written:
+//   {"filename":"..","name":"..","line":N,"status":"PASS|FAIL|IGNORE","message":"..",
+//    "duration_ns":N,"timing":{..},"benchmark":{..}|null}
+// (the last three with UNITY_SUPPORT_TIMING only).
+#ifdef UNITY_SUPPORT_TIMING
+#ifndef UNITY_REPORT_BINARY
+// a record stays on one line, so its parts are written without line breaks
+static void UnityJsonLine(const char* text)
+{
+    UnityPrint(text, UNITY_CHANNEL_JSON);
+}
+#endif
+
+static void UnityJsonTiming(const struct _UnityTiming* timing)
+{
+    const _US32 index = UNITY_CHANNEL_JSON;
+
+    UnityPrint(",\"duration_ns\":", index);
+    UnityPrintTime(UnityTimingTotal(timing), index);
+    UnityPrint(",\"timing\":{\"setup_ns\":", index);
+    UnityPrintTime(timing->Phase[UNITY_PHASE_SETUP], index);
+    UnityPrint(",\"test_ns\":", index);
+    UnityPrintTime(timing->Phase[UNITY_PHASE_TEST], index);
+    UnityPrint(",\"teardown_ns\":", index);
+    UnityPrintTime(timing->Phase[UNITY_PHASE_TEARDOWN], index);
+    UnityPrint(",\"cpu_ns\":", index);
+    UnityPrintTime(timing->Cpu, index);
+    UnityPrint("}", index);
+}
+
+static void UnityJsonBenchmark(const struct _UnityBenchmark* benchmark)
+{
+    const _US32 index = UNITY_CHANNEL_JSON;
+
+    if (benchmark->Samples == 0)
+    {
+        UnityPrint(",\"benchmark\":null", index);
+        return;
+    }
+    UnityPrint(",\"benchmark\":{\"samples\":", index);
+    UnityPrintNumberUnsigned(benchmark->Samples, index);
+    UnityPrint(",\"iterations\":", index);
+    UnityPrintNumberUnsigned(benchmark->Iterations, index);
+    UnityPrint(",\"min_ns\":", index);
+    UnityPrintThousandths(benchmark->Min, index);
+    UnityPrint(",\"median_ns\":", index);
+    UnityPrintThousandths(benchmark->Median, index);
+    UnityPrint(",\"p99_ns\":", index);
+    UnityPrintThousandths(benchmark->P99, index);
+    UnityPrint(",\"stddev_ns\":", index);
+    UnityPrintThousandths(benchmark->Stddev, index);
+    UnityPrint("}", index);
+}
+
+#endif
+/// open a JSON record with the keys that identify its test
+static void UnityJsonBeginRecord(const char* file, const char* name, const UNITY_LINE_TYPE line)
+{
+    const _US32 index = UNITY_CHANNEL_JSON;
+
+    UnitySwitchReport(file);
+    UnityPrint("{\"filename\":\"", index);
+    UnityPrintJson(file);
+    UnityPrint("\",\"name\":\"", index);
+    UnityPrintJson(name);
+    UnityPrint("\",\"line\":", index);
+    UnityPrintNumber(line, index);
+    UNITY_OUTPUT_CHAR(',', index);
+}
+
+static void UnityJsonEndRecord(void)
+{
+    UNITY_OUTPUT_CHAR('}', UNITY_CHANNEL_JSON);
+    UNITY_OUTPUT_CHAR('\n', UNITY_CHANNEL_JSON);
+}
+
+static void UnityJsonBeginTest(const struct _UnityResult* result)
+{
+    const _US32 index = UNITY_CHANNEL_JSON;
+
+    UnityJsonBeginRecord(result->File, result->TestName, result->TestLineNumber);
+    switch (result->Status)
+    {
+        case UNITY_RESULT_PASS:
+            UnityPrint("\"status\":\"PASS\"", index);
+            break;
+        case UNITY_RESULT_FAIL:
+            UnityPrint("\"status\":\"FAIL\"", index);
+            break;
+        case UNITY_RESULT_IGNORE:
+            UnityPrint("\"status\":\"IGNORE\"", index);
+            break;
+        case UNITY_RESULT_TIMEOUT:
+            UnityPrint("\"status\":\"TIMEOUT\"", index);
+            break;
+    }
+    UnityPrint(",\"message\":\"", index);
+    UnityJsonFirstField = 1;
+}
+
+static void UnityJsonField(const struct _UnityField* field, const char* text)
+{
+    UnityPrintField(field, text, UNITY_CHANNEL_JSON, UnityJsonFirstField);
+    UnityJsonFirstField = 0;
+}
+
+static void UnityJsonEndTest(const struct _UnityResult* result)
+{
+    UNITY_OUTPUT_CHAR('"', UNITY_CHANNEL_JSON);
+#ifdef UNITY_SUPPORT_TIMING
+    UnityJsonTiming(&result->Timing);
+    UnityJsonBenchmark(&result->Benchmark);
+#else
+    (void)result;
+#endif
+    UnityJsonEndRecord();
+}
+
+#else
+//-----------------------------------------------
+static void UnityJsonLine(const char* text)
+{
+    UnityPrint(text, UNITY_CHANNEL_JSON);
+    UNITY_OUTPUT_CHAR('\n', UNITY_CHANNEL_JSON);
+}
+
+#ifdef UNITY_SUPPORT_TIMING
+static void UnityJsonTiming(const struct _UnityTiming* timing)
+{
+    const _US32 index = UNITY_CHANNEL_JSON;
+
+    UnityPrint("\"duration_ns\":\"", index);
+    UnityPrintTime(UnityTimingTotal(timing), index);
+    UnityJsonLine("\",");
+    UnityPrint("\"timing\":{\"setup_ns\":\"", index);
+    UnityPrintTime(timing->Phase[UNITY_PHASE_SETUP], index);
+    UnityPrint("\",\"test_ns\":\"", index);
+    UnityPrintTime(timing->Phase[UNITY_PHASE_TEST], index);
+    UnityPrint("\",\"teardown_ns\":\"", index);
+    UnityPrintTime(timing->Phase[UNITY_PHASE_TEARDOWN], index);
+    UnityPrint("\",\"cpu_ns\":\"", index);
+    UnityPrintTime(timing->Cpu, index);
+    UnityJsonLine("\"},");
+}
+
+static void UnityJsonBenchmark(const struct _UnityBenchmark* benchmark)
+{
+    const _US32 index = UNITY_CHANNEL_JSON;
+
+    UnityPrint("\"benchmark\":{\"samples\":\"", index);
+    UnityPrintNumberUnsigned(benchmark->Samples, index);
+    UnityPrint("\",\"iterations\":\"", index);
+    UnityPrintNumberUnsigned(benchmark->Iterations, index);
+    UnityPrint("\",\"min_ns\":\"", index);
+    UnityPrintThousandths(benchmark->Min, index);
+    UnityPrint("\",\"median_ns\":\"", index);
+    UnityPrintThousandths(benchmark->Median, index);
+    UnityPrint("\",\"p99_ns\":\"", index);
+    UnityPrintThousandths(benchmark->P99, index);
+    UnityPrint("\",\"stddev_ns\":\"", index);
+    UnityPrintThousandths(benchmark->Stddev, index);
+    UnityJsonLine("\"},");
+}
+
+#endif
+/// open a JSON record with the keys that identify its test
+static void UnityJsonBeginRecord(const char* file, const char* name, const UNITY_LINE_TYPE line)
+{
+    const _US32 index = UNITY_CHANNEL_JSON;
+
+    UnitySwitchReport(file);
+    UnityJsonLine("{");
+    UnityPrint("\"filename\":\"", index);
+    UnityPrintJson(file);
+    UnityJsonLine("\",");
+    UnityPrint("\"functionn_name\":\"", index);
+    UnityPrintJson(name);
+    UnityJsonLine("\",");
+    UnityPrint("\"linenumber\":\"", index);
+    UnityPrintNumber(line, index);
+    UnityJsonLine("\",");
+}
+
+static void UnityJsonEndRecord(void)
+{
+    UnityJsonLine("}");
+}
+
+static void UnityJsonBeginTest(const struct _UnityResult* result)
+{
+    const _US32 index = UNITY_CHANNEL_JSON;
+
+    UnityJsonBeginRecord(result->File, result->TestName, result->TestLineNumber);
+#ifdef UNITY_SUPPORT_TIMING
+    UnityJsonTiming(&result->Timing);
+    if (result->Benchmark.Samples > 0)
+    {
+        UnityJsonBenchmark(&result->Benchmark);
+    }
+#endif
+
+    switch (result->Status)
+    {
+        case UNITY_RESULT_PASS:
+            UnityJsonLine("\"ignored\":\"NO\",");
+            UnityJsonLine("\"result\":\"PASS\",");
+            UnityPrint("\"message\":\"", index);
+            break;
+        case UNITY_RESULT_FAIL:
+            UnityJsonLine("\"IGNORE\":\"NOT IGNORED\",");
+            UnityJsonLine("\"result\":\"Fail\",");
+            UnityPrint("\"Message\":\"", index);
+            break;
+        case UNITY_RESULT_TIMEOUT:
+            UnityJsonLine("\"IGNORE\":\"NOT IGNORED\",");
+            UnityJsonLine("\"result\":\"Timeout\",");
+            UnityPrint("\"Message\":\"", index);
+            break;
+        case UNITY_RESULT_IGNORE:
+            UnityPrint("\"IGNORE\":\"", index);
+            break;
+    }
+    UnityJsonFirstField = 1;
+}
+
+static void UnityJsonField(const struct _UnityField* field, const char* text)
+{
+    UnityPrintField(field, text, UNITY_CHANNEL_JSON, UnityJsonFirstField);
+    UnityJsonFirstField = 0;
+}
+
+static void UnityJsonEndTest(const struct _UnityResult* result)
+{
+    if (result->Status == UNITY_RESULT_IGNORE)
+    {
+        UnityJsonLine("\",");
+        UnityJsonLine("\"Result\":\"\",");
+        UnityJsonLine("\"Message\":\"\"");
+    }
+    else
+    {
+        UnityJsonLine("\"");
+    }
+    UnityJsonEndRecord();
+}
+
+#endif
+
+const struct _UnitySink UnitySinkJson = { UnityJsonBeginTest, UnityJsonField, UnityJsonEndTest, 0 };
+
+const struct _UnitySink UnitySinkNone = { NULL, NULL, NULL, 0 };
+
+#ifdef UNITY_REPORT_BINARY
+//-----------------------------------------------
+// Binary Result Log
+//-----------------------------------------------
+// UnitySinkBinary writes each result as a varint encoded record holding the raw
+// expected and actual values and their display style rather than their text.
+// Strings are written once and referred to by id after that, and the table of
+// ids starts over every UNITY_BINARY_STRINGS strings.  unity_decode.c replays
+// a log through the other sinks.
+//
+// A test's record is assembled here while the strings it refers to are written
+// ahead of it, then goes out in one span
+#if (UNITY_BINARY_STRINGS < 4 * (UNITY_RESULT_MAX_FIELDS + 2))
+#error "UNITY_BINARY_STRINGS must hold the strings of a few records"
+#endif
+static unsigned char UnityBinaryRecord[512];
+static _UU32 UnityBinaryUsed;
+
+// Strings already written to this log, by hash, and the id each was given
+static unsigned long long UnityBinaryHashes[UNITY_BINARY_STRINGS];
+static unsigned long long UnityBinaryIds[UNITY_BINARY_STRINGS];
+static unsigned long long UnityBinaryStringCount;
+static const char* UnityBinaryFile;
+static int UnityBinaryStarted = 0;
+
+//-----------------------------------------------
+static _UU32 UnityEncodeVarint(unsigned char* buffer, unsigned long long value)
+{
+    _UU32 length = 0;
+
+    while (value >= 0x80)
+    {
+        buffer[length++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    buffer[length++] = (unsigned char)value;
+    return length;
+}
+
+static void UnityBinaryNumber(const unsigned long long value)
+{
+    UnityBinaryUsed += UnityEncodeVarint(&UnityBinaryRecord[UnityBinaryUsed], value);
+}
+
+/// zigzag encoded, so small negative numbers stay short
+static void UnityBinarySigned(const _U_SINT value)
+{
+    const unsigned long long doubled = (unsigned long long)(_U_UINT)value << 1;
+
+    UnityBinaryNumber((value < 0) ? ~doubled : doubled);
+}
+
+//-----------------------------------------------
+static void UnityBinaryTag(const UNITY_BINARY_TAG_T tag, const unsigned long long value)
+{
+    unsigned char buffer[11];
+
+    buffer[0] = (unsigned char)tag;
+    UnityPrintSpan((const char*)buffer, 1 + UnityEncodeVarint(&buffer[1], value), UNITY_CHANNEL_JSON);
+}
+
+//-----------------------------------------------
+static void UnityBinaryForget(void)
+{
+    memset(UnityBinaryHashes, 0, sizeof(UnityBinaryHashes));
+    UnityBinaryStringCount = 0;
+}
+
+//-----------------------------------------------
+/// the id of a string, writing it out the first time it is seen
+static unsigned long long UnityBinaryString(const char* string)
+{
+    unsigned char length[10];
+    unsigned long long hash = 14695981039346656037ULL;
+    size_t size;
+    _UU32 slot;
+
+    if (string == NULL)
+        return 0;
+
+    for (size = 0; string[size] != '\0'; size++)
+    {
+        hash = (hash ^ (unsigned char)string[size]) * 1099511628211ULL;
+    }
+    if (hash == 0)
+        hash = 1;
+
+    slot = (_UU32)(hash % UNITY_BINARY_STRINGS);
+    while (UnityBinaryHashes[slot] != 0)
+    {
+        if (UnityBinaryHashes[slot] == hash)
+            return UnityBinaryIds[slot];
+        slot = (slot + 1) % UNITY_BINARY_STRINGS;
+    }
+
+    UnityBinaryHashes[slot] = hash;
+    UnityBinaryIds[slot] = ++UnityBinaryStringCount;
+    UnityBinaryTag(UNITY_BINARY_STRING, UnityBinaryIds[slot]);
+    UnityPrintSpan((const char*)length, UnityEncodeVarint(length, size), UNITY_CHANNEL_JSON);
+    UnityPrintSpan(string, (_UU32)size, UNITY_CHANNEL_JSON);
+    return UnityBinaryIds[slot];
+}
+
+//-----------------------------------------------
+static void UnityBinaryBeginTest(const struct _UnityResult* result)
+{
+    unsigned long long name;
+
+    // each test file's log starts with its own header
+    if (UnitySwitchReport(result->File))
+        UnityBinaryStarted = 0;
+    if (!UnityBinaryStarted)
+    {
+        UnityBinaryRecord[0] = (unsigned char)UNITY_BINARY_VERSION;
+#ifdef UNITY_SUPPORT_TIMING
+        UnityBinaryRecord[1] = UNITY_BINARY_TIMED;
+#else
+        UnityBinaryRecord[1] = 0;
+#endif
+        UnityPrintSpan(UNITY_BINARY_MAGIC, 4, UNITY_CHANNEL_JSON);
+        UnityPrintSpan((const char*)UnityBinaryRecord, 2, UNITY_CHANNEL_JSON);
+        UnityBinaryForget();
+        UnityBinaryFile = NULL;
+        UnityBinaryStarted = 1;
+    }
+    // keep probes short: once the table is three quarters full, with room left for
+    // this record's strings, the reader is told to start over along with it
+    if (UnityBinaryStringCount + UNITY_RESULT_MAX_FIELDS + 2 > (UNITY_BINARY_STRINGS * 3) / 4)
+    {
+        UnityBinaryTag(UNITY_BINARY_RESET, 0);
+        UnityBinaryForget();
+        UnityBinaryFile = NULL;
+    }
+    if (UnityBinaryFile != result->File)
+    {
+        UnityBinaryFile = result->File;
+        UnityBinaryTag(UNITY_BINARY_FILE, UnityBinaryString(result->File));
+    }
+
+    name = UnityBinaryString(result->TestName);
+    UnityBinaryUsed = 0;
+    UnityBinaryRecord[UnityBinaryUsed++] = (unsigned char)UNITY_BINARY_TEST;
+    UnityBinaryNumber(name);
+    UnityBinaryNumber(result->TestLineNumber);
+    UnityBinaryNumber(result->LineNumber);
+    UnityBinaryNumber(result->Status);
+    UnityBinaryNumber(result->FieldCount);
+}
+
+/// values go in as they were captured; the reader formats them
+static void UnityBinaryField(const struct _UnityField* field, const char* text)
+{
+#ifdef UNITY_FLOAT_VERBOSE
+    unsigned long long bits;
+    double number;
+    _UU32 i;
+#endif
+
+    (void)text;
+    UnityBinaryNumber(field->Kind);
+    UnityBinaryNumber(field->Type);
+    switch (field->Type)
+    {
+        case UNITY_VALUE_NUMBER:
+            UnityBinaryNumber(field->Style);
+            UnityBinarySigned(field->Number);
+            break;
+        case UNITY_VALUE_MASK:
+            UnityBinarySigned(field->Mask);
+            UnityBinarySigned(field->Number);
+            break;
+#ifdef UNITY_FLOAT_VERBOSE
+        case UNITY_VALUE_FLOAT:
+            // always a little endian IEEE double, whatever _UF is
+            number = (double)field->Float;
+            memcpy(&bits, &number, sizeof(bits));
+            for (i = 0; i < 8; i++)
+            {
+                UnityBinaryRecord[UnityBinaryUsed++] = (unsigned char)(bits >> (i * 8));
+            }
+            break;
+#endif
+        default:
+            UnityBinaryNumber(UnityBinaryString(field->String));
+            break;
+    }
+}
+
+static void UnityBinaryEndTest(const struct _UnityResult* result)
+{
+#ifdef UNITY_SUPPORT_TIMING
+    const struct _UnityBenchmark* benchmark = &result->Benchmark;
+    _UU32 i;
+
+    for (i = 0; i < UNITY_PHASE_COUNT; i++)
+    {
+        UnityBinaryNumber(result->Timing.Phase[i]);
+    }
+    UnityBinaryNumber(result->Timing.Cpu);
+    UnityBinaryNumber(benchmark->Samples);
+    if (benchmark->Samples > 0)
+    {
+        UnityBinaryNumber(benchmark->Iterations);
+        UnityBinaryNumber(benchmark->Min);
+        UnityBinaryNumber(benchmark->Median);
+        UnityBinaryNumber(benchmark->P99);
+        UnityBinaryNumber(benchmark->Stddev);
+    }
+#else
+    (void)result;
+#endif
+    UnityPrintSpan((const char*)UnityBinaryRecord, UnityBinaryUsed, UNITY_CHANNEL_JSON);
+}
+
+const struct _UnitySink UnitySinkBinary = { UnityBinaryBeginTest, UnityBinaryField, UnityBinaryEndTest, 1 };
+#endif
+
+//-----------------------------------------------
+// JUnit XML Report
+//-----------------------------------------------
+// UnitySinkJUnit writes <TestFile>.xml, one <testsuite> per test file with each
+// <testcase> written as it is reported.  A suite's totals are only known once it
+// ends, so its opening tag leaves room for them and they are filled in when the
+// next test file starts or UnityEnd() closes the report.  A file that cannot be
+// written that way, such as a pipe, keeps its test cases and loses the totals,
+// and the console says so.
+
+// room for the totals at their widest, with 64 bit counts and nanoseconds
+#define UNITY_JUNIT_TOTALS_SIZE (136)
+
+static FILE* UnityJUnitFile = NULL;
+static char UnityJUnitName[256];
+static int UnityJUnitFailed = 0;
+static const char* UnityJUnitSuite = NULL;
+static int UnityJUnitOpen = 0;
+static long UnityJUnitTotals = -1;
+static unsigned long UnityJUnitTests;
+static unsigned long UnityJUnitFailures;
+static unsigned long UnityJUnitSkipped;
+#ifdef UNITY_SUPPORT_TIMING
+static _UT UnityJUnitTime;
+#endif
+
+// a failure's text, gathered from its fields for both the message and the body
+static char UnityJUnitMessage[UNITY_RESULT_MAX_FIELDS * UNITY_FIELD_TEXT_SIZE * 2];
+static size_t UnityJUnitMessageUsed;
+
+//-----------------------------------------------
+static void UnityJUnitXml(const char* string)
+{
+    const char* run = string;
+
+    if (string == NULL)
+        string = run = UnityStrNull;
+    for (; *string != '\0'; string++)
+    {
+        const char* entity;
+        switch (*string)
+        {
+            case '&':  entity = "&amp;";  break;
+            case '<':  entity = "&lt;";   break;
+            case '>':  entity = "&gt;";   break;
+            case '"':  entity = "&quot;"; break;
+            case '\n': entity = "&#10;";  break;
+            case '\r': entity = "&#13;";  break;
+            case '\t': entity = "&#9;";   break;
+            default:
+                // XML 1.0 cannot carry the other control characters at all
+                entity = ((unsigned char)*string < 0x20) ? "?" : NULL;
+                break;
+        }
+        if (entity != NULL)
+        {
+            fwrite(run, 1, (size_t)(string - run), UnityJUnitFile);
+            fputs(entity, UnityJUnitFile);
+            run = string + 1;
+        }
+    }
+    fwrite(run, 1, (size_t)(string - run), UnityJUnitFile);
+}
+
+//-----------------------------------------------
+#ifdef UNITY_SUPPORT_TIMING
+static void UnityJUnitSeconds(const _UT ns)
+{
+    fprintf(UnityJUnitFile, "%lu.%09lu", (unsigned long)(ns / 1000000000u), (unsigned long)(ns % 1000000000u));
+}
+#endif
+
+//-----------------------------------------------
+static void UnityJUnitWarn(const char* problem)
+{
+    UnityPrint(problem, UNITY_CHANNEL_CONSOLE);
+    UnityPrint(UnityJUnitName, UNITY_CHANNEL_CONSOLE);
+    UNITY_PRINT_EOL;
+}
+
+//-----------------------------------------------
+/// fill in the open suite's totals and close it
+static void UnityJUnitEndSuite(void)
+{
+    char totals[UNITY_JUNIT_TOTALS_SIZE + 1];
+    size_t length;
+    long end;
+
+    if (!UnityJUnitOpen)
+        return;
+    UnityJUnitOpen = 0;
+
+    fputs("  </testsuite>\n", UnityJUnitFile);
+    end = ftell(UnityJUnitFile);
+    length = (size_t)sprintf(totals, " tests=\"%lu\" failures=\"%lu\" skipped=\"%lu\"",
+                             UnityJUnitTests, UnityJUnitFailures, UnityJUnitSkipped);
+#ifdef UNITY_SUPPORT_TIMING
+    length += (size_t)sprintf(&totals[length], " time=\"%lu.%09lu\"",
+                              (unsigned long)(UnityJUnitTime / 1000000000u), (unsigned long)(UnityJUnitTime % 1000000000u));
+#endif
+    memset(&totals[length], ' ', UNITY_JUNIT_TOTALS_SIZE - length);
+    if ((UnityJUnitTotals < 0) || (end < 0) ||
+        (fseek(UnityJUnitFile, UnityJUnitTotals, SEEK_SET) != 0) ||
+        (fwrite(totals, 1, UNITY_JUNIT_TOTALS_SIZE, UnityJUnitFile) != UNITY_JUNIT_TOTALS_SIZE) ||
+        (fseek(UnityJUnitFile, end, SEEK_SET) != 0))
+    {
+        UnityJUnitWarn("JUnit Totals Could Not Be Written: ");
+    }
+}
+
+//-----------------------------------------------
+static void UnityJUnitBeginSuite(const char* file)
+{
+    char blank[UNITY_JUNIT_TOTALS_SIZE];
+
+    UnityJUnitSuite = file;
+    UnityJUnitTests = 0;
+    UnityJUnitFailures = 0;
+    UnityJUnitSkipped = 0;
+#ifdef UNITY_SUPPORT_TIMING
+    UnityJUnitTime = 0;
+#endif
+
+    fputs("  <testsuite name=\"", UnityJUnitFile);
+    UnityJUnitXml(file);
+    fputc('"', UnityJUnitFile);
+    UnityJUnitTotals = ftell(UnityJUnitFile);
+    memset(blank, ' ', sizeof(blank));
+    fwrite(blank, 1, sizeof(blank), UnityJUnitFile);
+    fputs(">\n", UnityJUnitFile);
+    UnityJUnitOpen = 1;
+}
+
+//-----------------------------------------------
+static void UnityJUnitAppend(const char* text)
+{
+    size_t length = strlen(text);
+
+    if (length > sizeof(UnityJUnitMessage) - 1 - UnityJUnitMessageUsed)
+        length = sizeof(UnityJUnitMessage) - 1 - UnityJUnitMessageUsed;
+    memcpy(&UnityJUnitMessage[UnityJUnitMessageUsed], text, length);
+    UnityJUnitMessageUsed += length;
+    UnityJUnitMessage[UnityJUnitMessageUsed] = '\0';
+}
+
+//-----------------------------------------------
+static void UnityJUnitBeginTest(const struct _UnityResult* result)
+{
+    if (UnityJUnitFile == NULL)
+    {
+        // a report that could not be opened is only tried, and reported, once
+        if (UnityJUnitFailed)
+            return;
+        UnityJUnitName[0] = '\0';
+        strncat(UnityJUnitName, (result->File != NULL) ? result->File : "unity", sizeof(UnityJUnitName) - sizeof(".xml"));
+        strcat(UnityJUnitName, ".xml");
+        UnityJUnitFile = fopen(UnityJUnitName, "w");
+        if (UnityJUnitFile == NULL)
+        {
+            UnityJUnitFailed = 1;
+            UnityJUnitWarn("JUnit Report Could Not Be Opened: ");
+            return;
+        }
+        fputs("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<testsuites>\n", UnityJUnitFile);
+    }
+    if (!UnityJUnitOpen || !UnitySameFile(UnityJUnitSuite, result->File))
+    {
+        UnityJUnitEndSuite();
+        UnityJUnitBeginSuite(result->File);
+    }
+
+    UnityJUnitTests++;
+    fputs("    <testcase classname=\"", UnityJUnitFile);
+    UnityJUnitXml(result->File);
+    fputs("\" name=\"", UnityJUnitFile);
+    UnityJUnitXml(result->TestName);
+    fprintf(UnityJUnitFile, "\" line=\"%lu\"", (unsigned long)result->TestLineNumber);
+#ifdef UNITY_SUPPORT_TIMING
+    fputs(" time=\"", UnityJUnitFile);
+    UnityJUnitSeconds(UnityTimingTotal(&result->Timing));
+    fputc('"', UnityJUnitFile);
+    UnityJUnitTime += UnityTimingTotal(&result->Timing);
+#endif
+    UnityJUnitMessageUsed = 0;
+    UnityJUnitMessage[0] = '\0';
+}
+
+static void UnityJUnitField(const struct _UnityField* field, const char* text)
+{
+    const char* label = UnityFieldLabel(field->Kind);
+    const int quoted = ((field->Type == UNITY_VALUE_STRING) && (field->String != NULL));
+
+    if (label != NULL)
+        UnityJUnitAppend(label);
+    else if (text[0] != ' ')
+        UnityJUnitAppend(" ");
+    if (quoted)
+        UnityJUnitAppend("'");
+    UnityJUnitAppend(text);
+    if (quoted)
+        UnityJUnitAppend("'");
+}
+
+static void UnityJUnitEndTest(const struct _UnityResult* result)
+{
+    // the fields start with a space, as they follow "FAIL:" on the console
+    const char* message = (UnityJUnitMessage[0] == ' ') ? &UnityJUnitMessage[1] : UnityJUnitMessage;
+
+    if (UnityJUnitFile == NULL)
+        return;
+
+    switch (result->Status)
+    {
+        case UNITY_RESULT_FAIL:
+        case UNITY_RESULT_TIMEOUT:
+            UnityJUnitFailures++;
+            fputs(">\n      <failure message=\"", UnityJUnitFile);
+            UnityJUnitXml(message);
+            fputs((result->Status == UNITY_RESULT_TIMEOUT) ? "\" type=\"TIMEOUT\">" : "\" type=\"FAIL\">", UnityJUnitFile);
+            UnityJUnitXml(result->File);
+            fprintf(UnityJUnitFile, ":%lu: ", (unsigned long)result->LineNumber);
+            UnityJUnitXml(message);
+            fputs("</failure>\n    </testcase>\n", UnityJUnitFile);
+            break;
+        case UNITY_RESULT_IGNORE:
+            UnityJUnitSkipped++;
+            fputs(">\n      <skipped message=\"", UnityJUnitFile);
+            UnityJUnitXml(message);
+            fputs("\"/>\n    </testcase>\n", UnityJUnitFile);
+            break;
+        default:
+            fputs("/>\n", UnityJUnitFile);
+            break;
+    }
+}
+
+//-----------------------------------------------
+static void UnityCloseJUnit(void)
+{
+    int failed;
+
+    UnityJUnitFailed = 0;
+    if (UnityJUnitFile == NULL)
+        return;
+    UnityJUnitEndSuite();
+    fputs("</testsuites>\n", UnityJUnitFile);
+    failed = ferror(UnityJUnitFile);
+    failed |= (fclose(UnityJUnitFile) != 0);
+    UnityJUnitFile = NULL;
+    if (failed)
+        UnityJUnitWarn("JUnit Report Could Not Be Written: ");
+}
+
+#ifdef UNITY_SUPPORT_FORK
+//-----------------------------------------------
+/// let go of the JUnit file without finishing it, as a forked child must; the parent flushed it before forking
+static void UnityDropJUnit(void)
+{
+    if (UnityJUnitFile != NULL)
+    {
+        fclose(UnityJUnitFile);
+        UnityJUnitFile = NULL;
+    }
+    UnityJUnitOpen = 0;
+}
+#endif
+
+const struct _UnitySink UnitySinkJUnit = { UnityJUnitBeginTest, UnityJUnitField, UnityJUnitEndTest, 0 };
+
+//-----------------------------------------------
+// Result Arena
+//-----------------------------------------------
+// A plain run only holds results back here, to report UNITY_RESULT_BATCH_SIZE
+// at a time, when the crash flush is left out: a crash cannot format what is
+// still queued.  The parallel and forked runners give each worker an arena of
+// its own to take its test's result.
+
+#if (UNITY_RESULT_ARENA_SIZE > 0)
+static struct _UnityResult UnityArenaResults[UNITY_RESULT_ARENA_SIZE];
+static struct _UnityField  UnityArenaFields[UNITY_RESULT_ARENA_FIELDS];
+static char                UnityArenaStrings[UNITY_RESULT_ARENA_STRINGS];
+
+static struct _UnityArena UnityDefaultArena =
+{
+    UnityArenaResults, UnityArenaFields, UnityArenaStrings,
+    UNITY_RESULT_ARENA_SIZE, UNITY_RESULT_ARENA_FIELDS, UNITY_RESULT_ARENA_STRINGS,
+    0, 0, 0,
+    UNITY_RESULT_BATCH_SIZE
+};
+#endif
+
+//-----------------------------------------------
+/// copy a string into the arena, truncating it if it can't fit
+static const char* UnityArenaCopyString(struct _UnityArena* arena, const char* string)
+{
+    _UU32 length;
+    _UU32 room = arena->StringCapacity - arena->StringCount;
+    char* copy;
+
+    if (string == NULL)
+        return NULL;
+    // queued records outlive what they point at, so a full arena leaves the field empty
+    if (room == 0)
+        return "";
+
+    length = (_UU32)strlen(string);
+    if (length >= room)
+        length = room - 1;
+
+    copy = &arena->Strings[arena->StringCount];
+    memcpy(copy, string, length);
+    copy[length] = '\0';
+    arena->StringCount += length + 1;
+    return copy;
+}
+
+//-----------------------------------------------
+void UnityCommitResult(const struct _UnityResult* result)
+{
+    struct _UnityArena* arena = Unity.Arena;
+    struct _UnityResult* record;
+    struct _UnityField* field;
+    _UU32 strings = 0;
+    _UU32 i;
+
+    if (arena == NULL)
+    {
+        UnityReportResult(result);
+        return;
+    }
+
+    for (i = 0; i < result->FieldCount; i++)
+    {
+        if (result->Fields[i].String != NULL)
+            strings += (_UU32)strlen(result->Fields[i].String) + 1;
+    }
+
+    // make room by reporting whatever is already queued
+    if ((arena->ResultCount == arena->ResultCapacity) ||
+        (arena->FieldCount + result->FieldCount > arena->FieldCapacity) ||
+        (arena->StringCount + strings > arena->StringCapacity))
+    {
+        UnityFlushResults();
+    }
+    if ((arena->ResultCapacity == 0) || (result->FieldCount > arena->FieldCapacity))
+    {
+        UnityReportResult(result);
+        return;
+    }
+
+    record = &arena->Results[arena->ResultCount++];
+    *record = *result;
+    record->Fields = &arena->Fields[arena->FieldCount];
+    for (i = 0; i < result->FieldCount; i++)
+    {
+        field = &arena->Fields[arena->FieldCount++];
+        *field = result->Fields[i];
+        field->String = UnityArenaCopyString(arena, field->String);
+    }
+
+    // a crash can only write out results that are already formatted
+    if ((arena->BatchSize > 0) && ((arena->ResultCount >= arena->BatchSize) || UNITY_CRASH_FLUSH_ACTIVE()))
+    {
+        UnityFlushResults();
+    }
+}
+
+//-----------------------------------------------
+void UnityFlushResults(void)
+{
+    struct _UnityArena* arena = Unity.Arena;
+    _UU32 i;
+
+    if (arena == NULL)
+        return;
+
+    for (i = 0; i < arena->ResultCount; i++)
+    {
+        UnityReportResult(&arena->Results[i]);
+    }
+    arena->ResultCount = 0;
+    arena->FieldCount = 0;
+    arena->StringCount = 0;
+}
+
+//-----------------------------------------------
+// Result Construction
+//-----------------------------------------------
+
+static struct _UnityField* UnityAddField(const UNITY_FIELD_T kind, const UNITY_VALUE_T type)
+{
+    static UNITY_THREAD_LOCAL struct _UnityField overflow;
+    struct _UnityField* field = &overflow;
+
+    // extra fields are dropped rather than corrupting the record
+    if (Unity.CurrentResult.FieldCount < UNITY_RESULT_MAX_FIELDS)
+    {
+        field = &Unity.CurrentFields[Unity.CurrentResult.FieldCount++];
+    }
+    field->Kind = kind;
+    field->Type = type;
+    field->String = NULL;
+    return field;
+}
+
+//-----------------------------------------------
+/// copy a field's string out of the test's frame, which is gone by the time the result is committed
+static const char* UnityKeepString(const char* string)
+{
+    _UU32 room = (_UU32)sizeof(Unity.CurrentStrings) - Unity.CurrentStringCount;
+    _UU32 length;
+    char* copy;
+
+    if (string == NULL)
+        return NULL;
+    // out of room: an empty field, as the string may live in the frame or buffer it came from
+    if (room == 0)
+        return "";
+
+    length = (_UU32)strlen(string);
+    if (length >= room)
+        length = room - 1;
+
+    copy = &Unity.CurrentStrings[Unity.CurrentStringCount];
+    memcpy(copy, string, length);
+    copy[length] = '\0';
+    Unity.CurrentStringCount += length + 1;
+    return copy;
+}
+
+//-----------------------------------------------
+static void UnityAddDetail(const char* text)
+{
+    UnityAddField(UNITY_FIELD_DETAIL, UNITY_VALUE_TEXT)->String = UnityKeepString(text);
+}
+
+//-----------------------------------------------
+static void UnityAddNumber(const UNITY_FIELD_T kind, const _U_SINT number, const UNITY_DISPLAY_STYLE_T style)
+{
+    struct _UnityField* field = UnityAddField(kind, UNITY_VALUE_NUMBER);
+    field->Number = number;
+    field->Style = style;
+}
+
+//-----------------------------------------------
+static void UnityAddMask(const UNITY_FIELD_T kind, const _U_SINT mask, const _U_SINT number)
+{
+    struct _UnityField* field = UnityAddField(kind, UNITY_VALUE_MASK);
+    field->Mask = mask;
+    field->Number = number;
+}
+
+//-----------------------------------------------
+static void UnityAddString(const UNITY_FIELD_T kind, const char* string)
+{
+    UnityAddField(kind, UNITY_VALUE_STRING)->String = UnityKeepString(string);
+}
+
+//-----------------------------------------------
+#ifdef UNITY_FLOAT_VERBOSE
+static void UnityAddFloat(const UNITY_FIELD_T kind, const _UF number)
+{
+    UnityAddField(kind, UNITY_VALUE_FLOAT)->Float = number;
+}
+#endif
+
+//-----------------------------------------------
+void UnityTestResultsFailBegin(const UNITY_LINE_TYPE line)
+{
+    Unity.CurrentResult.LineNumber = line;
+    Unity.CurrentResult.Fields = Unity.CurrentFields;
+    Unity.CurrentResult.FieldCount = 0;
+    Unity.CurrentStringCount = 0;
+}
+
+//-----------------------------------------------
+void UnityConcludeTest()
+{
+    struct _UnityResult* result = &Unity.CurrentResult;
+
+    if (Unity.CurrentTestIgnored)
+    {
+        Unity.TestIgnores++;
+        result->Status = UNITY_RESULT_IGNORE;
+    }
+    else if (!Unity.CurrentTestFailed)
+    {
+        result->Status = UNITY_RESULT_PASS;
+        result->LineNumber = Unity.CurrentTestLineNumber;
+        result->FieldCount = 0;
+    }
+    else
+    {
+        Unity.TestFailures++;
+        result->Status = Unity.CurrentTestTimedOut ? UNITY_RESULT_TIMEOUT : UNITY_RESULT_FAIL;
+    }
+
+    result->File = Unity.TestFile;
+    result->TestName = Unity.CurrentTestName;
+    result->TestLineNumber = Unity.CurrentTestLineNumber;
+    result->Fields = Unity.CurrentFields;
+#ifdef UNITY_SUPPORT_TIMING
+    result->Timing = Unity.CurrentTiming;
+    result->Benchmark = Unity.CurrentBenchmark;
+    memset(&Unity.CurrentTiming, 0, sizeof(Unity.CurrentTiming));
+    memset(&Unity.CurrentBenchmark, 0, sizeof(Unity.CurrentBenchmark));
+#endif
+    UnityCommitResult(result);
+    result->FieldCount = 0;
+    Unity.CurrentStringCount = 0;
+
+    Unity.CurrentTestFailed = 0;
+    Unity.CurrentTestIgnored = 0;
+    Unity.CurrentTestTimedOut = 0;
+}
+
+//-----------------------------------------------
+void UnityAddMsgIfSpecified(const char* msg)
+{
+    if (msg)
+    {
+        UnityAddField(UNITY_FIELD_MESSAGE, UNITY_VALUE_TEXT)->String = UnityKeepString(msg);
+    }
+}
+
+//-----------------------------------------------
+void UnityAddExpectedAndActualStrings(const char* expected, const char* actual)
+{
+    UnityAddString(UNITY_FIELD_EXPECTED, expected);
+    UnityAddString(UNITY_FIELD_ACTUAL, actual);
+}
+
+//-----------------------------------------------
+// Assertion & Control Helpers
+//-----------------------------------------------
+
+int UnityCheckArraysForNull(const void* expected, const void* actual, const UNITY_LINE_TYPE lineNumber, const char* msg)
+{
+    //return true if they are both NULL
+    if ((expected == NULL) && (actual == NULL))
+        return 1;
+
+    //throw error if just expected is NULL
+    if (expected == NULL)
+    {
+        UnityTestResultsFailBegin(lineNumber);
+        UnityAddDetail(UnityStrNullPointerForExpected);
+        UnityAddMsgIfSpecified(msg);
+        UNITY_FAIL_AND_BAIL;
+    }
+
+    //throw error if just actual is NULL
+    if (actual == NULL)
+    {
+        UnityTestResultsFailBegin(lineNumber);
+        UnityAddDetail(UnityStrNullPointerForActual);
+        UnityAddMsgIfSpecified(msg);
+        UNITY_FAIL_AND_BAIL;
+    }
+
+    //return false if neither is NULL
+    return 0;
+}
+
+//-----------------------------------------------
+// Memory Comparison
+//-----------------------------------------------
+// Equal memory is skipped 16 (SSE2) or 32 (AVX2) bytes at a time where the
+// compiler offers them, and a word at a time elsewhere.
+
+#if defined(UNITY_SIMD_SSE2) || defined(UNITY_SIMD_AVX2)
+/// index of the lowest set bit of a non-zero mask
+static _UU32 UnityLowestBit(_UU32 mask)
+{
+#ifdef __GNUC__
+    return (_UU32)__builtin_ctz(mask);
+#else
+    _UU32 bit = 0;
+    while ((mask & 1u) == 0)
+    {
+        mask >>= 1;
+        bit++;
+    }
+    return bit;
+#endif
+}
+#endif
+
+//-----------------------------------------------
+/// portable kernel: a machine word at a time, then the bytes of the word that differed
+static size_t UnityFirstDifferenceWords(const unsigned char* expected, const unsigned char* actual, size_t i, const size_t size)
+{
+    size_t word_exp, word_act;
+
+    while (i + sizeof(size_t) <= size)
+    {
+        memcpy(&word_exp, &expected[i], sizeof(size_t));
+        memcpy(&word_act, &actual[i], sizeof(size_t));
+        if (word_exp != word_act)
+            break;
+        i += sizeof(size_t);
+    }
+    while ((i < size) && (expected[i] == actual[i]))
+    {
+        i++;
+    }
+    return i;
+}
+
+#if defined(UNITY_SIMD_SSE2) && !defined(UNITY_SIMD_AVX2)
+//-----------------------------------------------
+static size_t UnityFirstDifferenceSse2(const unsigned char* expected, const unsigned char* actual, const size_t size)
+{
+    size_t i = 0;
+    _UU32 mask;
+    __m128i same0, same1, same2, same3;
+
+    // 64 bytes a round; narrow down only once something differs
+    while (i + 64 <= size)
+    {
+        same0 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)&expected[i]),      _mm_loadu_si128((const __m128i*)&actual[i]));
+        same1 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)&expected[i + 16]), _mm_loadu_si128((const __m128i*)&actual[i + 16]));
+        same2 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)&expected[i + 32]), _mm_loadu_si128((const __m128i*)&actual[i + 32]));
+        same3 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)&expected[i + 48]), _mm_loadu_si128((const __m128i*)&actual[i + 48]));
+        if (_mm_movemask_epi8(_mm_and_si128(_mm_and_si128(same0, same1), _mm_and_si128(same2, same3))) != 0xFFFF)
+            break;
+        i += 64;
+    }
+    while (i + 16 <= size)
+    {
+        same0 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)&expected[i]), _mm_loadu_si128((const __m128i*)&actual[i]));
+        mask = (_UU32)_mm_movemask_epi8(same0) ^ 0xFFFFu;
+        if (mask != 0)
+            return i + UnityLowestBit(mask);
+        i += 16;
+    }
+    return UnityFirstDifferenceWords(expected, actual, i, size);
+}
+#endif
+
+#if defined(UNITY_SIMD_AVX2) || defined(UNITY_SIMD_AVX2_DISPATCH)
+//-----------------------------------------------
+#ifdef UNITY_SIMD_AVX2_DISPATCH
+__attribute__((target("avx2")))
+#endif
+static size_t UnityFirstDifferenceAvx2(const unsigned char* expected, const unsigned char* actual, const size_t size)
+{
+    size_t i = 0;
+    _UU32 mask;
+    __m256i same0, same1, same2, same3;
+
+    // 128 bytes a round; narrow down only once something differs
+    while (i + 128 <= size)
+    {
+        same0 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)&expected[i]),      _mm256_loadu_si256((const __m256i*)&actual[i]));
+        same1 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)&expected[i + 32]), _mm256_loadu_si256((const __m256i*)&actual[i + 32]));
+        same2 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)&expected[i + 64]), _mm256_loadu_si256((const __m256i*)&actual[i + 64]));
+        same3 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)&expected[i + 96]), _mm256_loadu_si256((const __m256i*)&actual[i + 96]));
+        if ((_UU32)_mm256_movemask_epi8(_mm256_and_si256(_mm256_and_si256(same0, same1), _mm256_and_si256(same2, same3))) != 0xFFFFFFFFu)
+            break;
+        i += 128;
+    }
+    while (i + 32 <= size)
+    {
+        same0 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)&expected[i]), _mm256_loadu_si256((const __m256i*)&actual[i]));
+        mask = (_UU32)_mm256_movemask_epi8(same0) ^ 0xFFFFFFFFu;
+        if (mask != 0)
+            return i + UnityLowestBit(mask);
+        i += 32;
+    }
+    return UnityFirstDifferenceWords(expected, actual, i, size);
+}
+#endif
+
+//-----------------------------------------------
+/// offset of the first byte that differs, or size if the blocks are equal
+static size_t UnityFirstDifference(const void* expected, const void* actual, const size_t size)
+{
+    const unsigned char* ptr_exp = (const unsigned char*)expected;
+    const unsigned char* ptr_act = (const unsigned char*)actual;
+
+#if defined(UNITY_SIMD_AVX2)
+    return UnityFirstDifferenceAvx2(ptr_exp, ptr_act, size);
+#elif defined(UNITY_SIMD_AVX2_DISPATCH)
+    if (__builtin_cpu_supports("avx2"))
+        return UnityFirstDifferenceAvx2(ptr_exp, ptr_act, size);
+    return UnityFirstDifferenceSse2(ptr_exp, ptr_act, size);
+#elif defined(UNITY_SIMD_SSE2)
+    return UnityFirstDifferenceSse2(ptr_exp, ptr_act, size);
+#else
+    return UnityFirstDifferenceWords(ptr_exp, ptr_act, 0, size);
+#endif
+}
+
+//-----------------------------------------------
+// Assertion Functions
+//-----------------------------------------------
+
+void UnityAssertBits(const _U_SINT mask,
+                     const _U_SINT expected,
+                     const _U_SINT actual,
+                     const char* msg,
+                     const UNITY_LINE_TYPE lineNumber)
+{
+    if ((mask & expected) != (mask & actual))
+    {
+        UnityFailBits(mask, expected, actual, msg, lineNumber);
+    }
+}
+
+//-----------------------------------------------
+void UnityFailBits(const _U_SINT mask,
+                   const _U_SINT expected,
+                   const _U_SINT actual,
+                   const char* msg,
+                   const UNITY_LINE_TYPE lineNumber)
+{
+    UNITY_SKIP_EXECUTION;
+
+    UnityTestResultsFailBegin(lineNumber);
+    UnityAddMask(UNITY_FIELD_EXPECTED, mask, expected);
+    UnityAddMask(UNITY_FIELD_ACTUAL, mask, actual);
+    UnityAddMsgIfSpecified(msg);
+    UNITY_FAIL_AND_BAIL;
+}
+
+//-----------------------------------------------
+void UnityAssertEqualNumber(const _U_SINT expected,
+                            const _U_SINT actual,
+                            const char* msg,
+                            const UNITY_LINE_TYPE lineNumber,
                             const UNITY_DISPLAY_STYLE_T style)
 {
-    UNITY_SKIP_EXECUTION;
-    _US32 index;
-    if (expected != actual)
+    if (expected != actual)
+    {
+        UnityFailEqualNumber(expected, actual, msg, lineNumber, style);
+    }
+}
+
+//-----------------------------------------------
+void UnityFailEqualNumber(const _U_SINT expected,
+                          const _U_SINT actual,
+                          const char* msg,
+                          const UNITY_LINE_TYPE lineNumber,
+                          const UNITY_DISPLAY_STYLE_T style)
+{
+    UNITY_SKIP_EXECUTION;
+
+    UnityTestResultsFailBegin(lineNumber);
+    UnityAddNumber(UNITY_FIELD_EXPECTED, expected, style);
+    UnityAddNumber(UNITY_FIELD_ACTUAL, actual, style);
+    UnityAddMsgIfSpecified(msg);
+    UNITY_FAIL_AND_BAIL;
+}
+
+//-----------------------------------------------
+// Full Diff
+//-----------------------------------------------
+// With UnityFullDiff set, array and memory assertions read both arrays to the end
+// instead of stopping at the first mismatch, and summarize every run of differing
+// elements along with the first and last of them.
+
+int UnityFullDiff = UNITY_FULL_DIFF;
+
+#define UNITY_DIFF_TEXT_SIZE (UNITY_FIELD_TEXT_SIZE * 3)
+
+struct _UnityDiff
+{
+    _UU32 First[UNITY_DIFF_MAX_RANGES];
+    _UU32 Last[UNITY_DIFF_MAX_RANGES];
+    _UU32 RangeCount;   // every run found, including those past UNITY_DIFF_MAX_RANGES
+    _UU32 Total;
+    _UU32 LastElement;
+};
+
+//-----------------------------------------------
+/// record elements first..last as differing, joining them to the previous run if they follow on
+static void UnityDiffAdd(struct _UnityDiff* diff, const _UU32 first, const _UU32 last)
+{
+    if ((diff->Total > 0) && (diff->LastElement + 1 == first))
+    {
+        if (diff->RangeCount <= UNITY_DIFF_MAX_RANGES)
+        {
+            diff->Last[diff->RangeCount - 1] = last;
+        }
+    }
+    else
+    {
+        if (diff->RangeCount < UNITY_DIFF_MAX_RANGES)
+        {
+            diff->First[diff->RangeCount] = first;
+            diff->Last[diff->RangeCount] = last;
+        }
+        diff->RangeCount++;
+    }
+    diff->Total += last - first + 1;
+    diff->LastElement = last;
+}
+
+//-----------------------------------------------
+/// find every run of differing elements in two arrays of count elements, width bytes each
+static void UnityDiffMemory(struct _UnityDiff* diff, const unsigned char* expected, const unsigned char* actual, const size_t width, const size_t count)
+{
+    const size_t size = width * count;
+    size_t offset = 0;
+    size_t first, last;
+
+    memset(diff, 0, sizeof(*diff));
+    for (;;)
+    {
+        // the kernel skips the equal stretches, and a run is walked to its end an element at a time
+        offset += UnityFirstDifference(&expected[offset], &actual[offset], size - offset);
+        if (offset >= size)
+            break;
+
+        first = offset / width;
+        last = first;
+        while ((last + 1 < count) && (memcmp(&expected[(last + 1) * width], &actual[(last + 1) * width], width) != 0))
+        {
+            last++;
+        }
+        UnityDiffAdd(diff, (_UU32)first, (_UU32)last);
+        offset = (last + 1) * width;
+    }
+}
+
+//-----------------------------------------------
+static _UU32 UnityDiffAppend(char* text, const _UU32 length, const char* string)
+{
+    strcpy(&text[length], string);
+    return length + (_UU32)strlen(string);
+}
+
+//-----------------------------------------------
+/// "<total> Of <count><what> In 120-4095, 4100 (+N More Runs)<tail>" into a UNITY_DIFF_TEXT_SIZE buffer
+static void UnityDiffSummary(char* text, const struct _UnityDiff* diff, const _UU32 count, const char* what, const char* tail)
+{
+    // room for one more range of 20 digit numbers, the run counter and the tail
+    const _UU32 reserve = 2 * 20 + 3 + 34 + (_UU32)strlen(tail);
+    _UU32 length, i;
+
+    length = UnityFormatNumberUnsigned(text, diff->Total);
+    length = UnityDiffAppend(text, length, " Of ");
+    length += UnityFormatNumberUnsigned(&text[length], count);
+    length = UnityDiffAppend(text, length, what);
+    length = UnityDiffAppend(text, length, " In ");
+
+    for (i = 0; (i < diff->RangeCount) && (i < UNITY_DIFF_MAX_RANGES); i++)
+    {
+        if (length + reserve >= UNITY_DIFF_TEXT_SIZE)
+            break;
+        if (i > 0)
+        {
+            length = UnityDiffAppend(text, length, ", ");
+        }
+        length += UnityFormatNumberUnsigned(&text[length], diff->First[i]);
+        if (diff->Last[i] != diff->First[i])
+        {
+            text[length++] = '-';
+            length += UnityFormatNumberUnsigned(&text[length], diff->Last[i]);
+        }
+    }
+
+    if (i < diff->RangeCount)
+    {
+        length = UnityDiffAppend(text, length, " (+");
+        length += UnityFormatNumberUnsigned(&text[length], diff->RangeCount - i);
+        length = UnityDiffAppend(text, length, " More Runs)");
+    }
+    strcpy(&text[length], tail);
+}
+
+//-----------------------------------------------
+/// " Expected <x> Was <y>" after the location of the last mismatch
+static void UnityDiffValues(char* text, _UU32 length, const _U_SINT expected, const _U_SINT actual, const UNITY_DISPLAY_STYLE_T style)
+{
+    length = UnityDiffAppend(text, length, UnityStrExpected);
+    length += UnityFormatNumberByStyle(&text[length], expected, style);
+    length = UnityDiffAppend(text, length, UnityStrWas);
+    UnityFormatNumberByStyle(&text[length], actual, style);
+}
+
+//-----------------------------------------------
+static void UnityFailElement(const _UU32 element,
+                             const _U_SINT expected,
+                             const _U_SINT actual,
+                             const char* msg,
+                             const UNITY_LINE_TYPE lineNumber,
+                             const UNITY_DISPLAY_STYLE_T style)
+{
+    UnityTestResultsFailBegin(lineNumber);
+    UnityAddNumber(UNITY_FIELD_ELEMENT, (_U_SINT)element, UNITY_DISPLAY_STYLE_UINT);
+    UnityAddNumber(UNITY_FIELD_EXPECTED, expected, style);
+    UnityAddNumber(UNITY_FIELD_ACTUAL, actual, style);
+    UnityAddMsgIfSpecified(msg);
+    UNITY_FAIL_AND_BAIL;
+}
+
+//-----------------------------------------------
+/// load one element of the given width, unaligned and sign extended
+static _U_SINT UnityReadElement(const _US8* ptr, const _UU32 width)
+{
+    _US16 value16;
+    _US32 value32;
+#ifdef UNITY_SUPPORT_64
+    _US64 value64;
+#endif
+
+    switch (width)
+    {
+        case 1:
+            return (_U_SINT)*ptr;
+        case 2:
+            memcpy(&value16, ptr, sizeof(value16));
+            return (_U_SINT)value16;
+#ifdef UNITY_SUPPORT_64
+        case 8:
+            memcpy(&value64, ptr, sizeof(value64));
+            return (_U_SINT)value64;
+#endif
+        default:
+            memcpy(&value32, ptr, sizeof(value32));
+            return (_U_SINT)value32;
+    }
+}
+
+//-----------------------------------------------
+void UnityAssertEqualIntArray(const _U_SINT* expected,
+                              const _U_SINT* actual,
+                              const _UU32 num_elements,
+                              const char* msg,
+                              const UNITY_LINE_TYPE lineNumber,
+                              const UNITY_DISPLAY_STYLE_T style)
+{
+    const _US8* ptr_exp = (const _US8*)expected;
+    const _US8* ptr_act = (const _US8*)actual;
+    _UU32 width;
+    size_t element;
+
+    UNITY_SKIP_EXECUTION;
+
+    if (num_elements == 0)
+    {
+        UnityTestResultsFailBegin(lineNumber);
+        UnityAddDetail(UnityStrPointless);
+        UnityAddMsgIfSpecified(msg);
+        UNITY_FAIL_AND_BAIL;
+    }
+
+    if (UnityCheckArraysForNull((void*)expected, (void*)actual, lineNumber, msg) == 1)
+        return;
+
+    switch(style)
+    {
+        case UNITY_DISPLAY_STYLE_HEX8:
+        case UNITY_DISPLAY_STYLE_INT8:
+        case UNITY_DISPLAY_STYLE_UINT8:
+            width = 1;
+            break;
+        case UNITY_DISPLAY_STYLE_HEX16:
+        case UNITY_DISPLAY_STYLE_INT16:
+        case UNITY_DISPLAY_STYLE_UINT16:
+            width = 2;
+            break;
+#ifdef UNITY_SUPPORT_64
+        case UNITY_DISPLAY_STYLE_HEX64:
+        case UNITY_DISPLAY_STYLE_INT64:
+        case UNITY_DISPLAY_STYLE_UINT64:
+            width = 8;
+            break;
+#endif
+        default:
+            width = 4;
+            break;
+    }
+
+    // elements are equal exactly when all their bytes are, so the memory kernel
+    // finds the first differing element whatever the width
+    element = UnityFirstDifference(ptr_exp, ptr_act, (size_t)num_elements * width) / width;
+    if ((element < num_elements) && UnityFullDiff)
+    {
+        struct _UnityDiff diff;
+        char summary[UNITY_DIFF_TEXT_SIZE];
+        char last[UNITY_DIFF_TEXT_SIZE];
+
+        UnityDiffMemory(&diff, (const unsigned char*)ptr_exp, (const unsigned char*)ptr_act, width, num_elements);
+        UnityDiffSummary(summary, &diff, num_elements, " Elements Differ", ", First At");
+        strcpy(last, "Last At Element ");
+        UnityDiffValues(last, 16 + UnityFormatNumberUnsigned(&last[16], diff.LastElement),
+                        UnityReadElement(&ptr_exp[diff.LastElement * width], width),
+                        UnityReadElement(&ptr_act[diff.LastElement * width], width), style);
+
+        UnityTestResultsFailBegin(lineNumber);
+        UnityAddDetail(summary);
+        UnityAddNumber(UNITY_FIELD_ELEMENT, (_U_SINT)element, UNITY_DISPLAY_STYLE_UINT);
+        UnityAddNumber(UNITY_FIELD_EXPECTED, UnityReadElement(&ptr_exp[element * width], width), style);
+        UnityAddNumber(UNITY_FIELD_ACTUAL, UnityReadElement(&ptr_act[element * width], width), style);
+        UnityAddDetail(last);
+        UnityAddMsgIfSpecified(msg);
+        UNITY_FAIL_AND_BAIL;
+    }
+    if (element < num_elements)
+    {
+        UnityFailElement((_UU32)element,
+                         UnityReadElement(&ptr_exp[element * width], width),
+                         UnityReadElement(&ptr_act[element * width], width),
+                         msg, lineNumber, style);
+    }
+}
+
+//-----------------------------------------------
+#if !defined(UNITY_EXCLUDE_FLOAT) || !defined(UNITY_EXCLUDE_DOUBLE)
+// Tolerance checks scan arrays in blocks this long: a quick pass (SSE2 where available)
+// flags blocks that may hold a mismatch, and only those are checked exactly
+#define UNITY_FLOAT_BLOCK (64)
+
+// how badly a NaN or infinity mismatch misses, so it always counts as the worst
+#define UNITY_FLOAT_MISS_SPECIAL (1e300)
+
+//-----------------------------------------------
+/// map a float or double to an integer that orders like the value itself, with -0 == +0
+static unsigned long long UnityFloatOrdinal(const void* value, const size_t size)
+{
+    const unsigned long long middle = (size == 4) ? 0x80000000ULL : 0x8000000000000000ULL;
+    unsigned long long magnitude;
+    _UU32 bits32;
+
+    if (size == 4)
+    {
+        memcpy(&bits32, value, 4);
+        magnitude = (unsigned long long)(bits32 & 0x7FFFFFFFu);
+        return (bits32 & 0x80000000u) ? (middle - magnitude) : (middle + magnitude);
+    }
+    memcpy(&magnitude, value, 8);
+    if (magnitude & middle)
+        return middle - (magnitude & ~middle);
+    return middle + magnitude;
+}
+
+#if defined(UNITY_SIMD_SSE2) && !defined(UNITY_EXCLUDE_FLOAT)
+//-----------------------------------------------
+/// SSE2 pre-scan of count (a multiple of 4) floats; non-zero if any lane may be out of tolerance
+static int UnitySuspectSse2Float(const float* expected, const float* actual, const _UU32 count, const float tolerance, const int relative)
+{
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    const __m128 tol = _mm_set1_ps(tolerance);
+    __m128 all_ok = _mm_castsi128_ps(_mm_set1_epi32(-1));
+    __m128 exp, act, diff, limit;
+    _UU32 i;
+
+    for (i = 0; i < count; i += 4)
+    {
+        exp = _mm_loadu_ps(&expected[i]);
+        act = _mm_loadu_ps(&actual[i]);
+        diff = _mm_andnot_ps(sign, _mm_sub_ps(exp, act));
+        limit = relative ? _mm_mul_ps(_mm_andnot_ps(sign, exp), tol) : tol;
+        // NaN compares false, and x - x is NaN for infinities
+        all_ok = _mm_and_ps(all_ok, _mm_cmple_ps(diff, limit));
+        all_ok = _mm_and_ps(all_ok, _mm_cmpeq_ps(_mm_sub_ps(exp, exp), _mm_sub_ps(act, act)));
+    }
+    return _mm_movemask_ps(all_ok) != 0xF;
+}
+
+//-----------------------------------------------
+/// SSE2 pre-scan of count (a multiple of 4) floats; non-zero if any lane may be more than ulps apart
+static int UnitySuspectSse2FloatUlp(const float* expected, const float* actual, const _UU32 count, const _US32 ulps)
+{
+    const __m128i magnitude = _mm_set1_epi32(0x7FFFFFFF);
+    const __m128i special = _mm_set1_epi32(0x7F800000);
+    const __m128i limit = _mm_set1_epi32(ulps);
+    __m128i suspect = _mm_setzero_si128();
+    __m128i exp, act, sign, distance;
+    _UU32 i;
+
+    for (i = 0; i < count; i += 4)
+    {
+        exp = _mm_loadu_si128((const __m128i*)&expected[i]);
+        act = _mm_loadu_si128((const __m128i*)&actual[i]);
+        // NaNs and infinities, with every exponent bit set, are left to the exact check
+        suspect = _mm_or_si128(suspect, _mm_cmpeq_epi32(_mm_and_si128(exp, special), special));
+        suspect = _mm_or_si128(suspect, _mm_cmpeq_epi32(_mm_and_si128(act, special), special));
+        // sign and magnitude to two's complement, the 32 bit UnityFloatOrdinal() less its offset
+        sign = _mm_srai_epi32(exp, 31);
+        exp = _mm_sub_epi32(_mm_xor_si128(_mm_and_si128(exp, magnitude), sign), sign);
+        sign = _mm_srai_epi32(act, 31);
+        act = _mm_sub_epi32(_mm_xor_si128(_mm_and_si128(act, magnitude), sign), sign);
+        distance = _mm_sub_epi32(exp, act);
+        // a distance that overflowed is 2^31 or more
+        suspect = _mm_or_si128(suspect, _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(exp, act), _mm_xor_si128(exp, distance)), 31));
+        sign = _mm_srai_epi32(distance, 31);
+        distance = _mm_sub_epi32(_mm_xor_si128(distance, sign), sign);
+        // and the one whose magnitude is 2^31 stays negative
+        suspect = _mm_or_si128(suspect, _mm_srai_epi32(distance, 31));
+        suspect = _mm_or_si128(suspect, _mm_cmpgt_epi32(distance, limit));
+    }
+    return _mm_movemask_epi8(suspect) != 0;
+}
+#endif
+
+#if defined(UNITY_SIMD_SSE2) && !defined(UNITY_EXCLUDE_DOUBLE)
+//-----------------------------------------------
+/// SSE2 pre-scan of count (a multiple of 2) doubles; non-zero if any lane may be out of tolerance
+static int UnitySuspectSse2Double(const double* expected, const double* actual, const _UU32 count, const double tolerance, const int relative)
+{
+    const __m128d sign = _mm_set1_pd(-0.0);
+    const __m128d tol = _mm_set1_pd(tolerance);
+    __m128d all_ok = _mm_castsi128_pd(_mm_set1_epi32(-1));
+    __m128d exp, act, diff, limit;
+    _UU32 i;
+
+    for (i = 0; i < count; i += 2)
+    {
+        exp = _mm_loadu_pd(&expected[i]);
+        act = _mm_loadu_pd(&actual[i]);
+        diff = _mm_andnot_pd(sign, _mm_sub_pd(exp, act));
+        limit = relative ? _mm_mul_pd(_mm_andnot_pd(sign, exp), tol) : tol;
+        all_ok = _mm_and_pd(all_ok, _mm_cmple_pd(diff, limit));
+        all_ok = _mm_and_pd(all_ok, _mm_cmpeq_pd(_mm_sub_pd(exp, exp), _mm_sub_pd(act, act)));
+    }
+    return _mm_movemask_pd(all_ok) != 0x3;
+}
+#endif
+
+//-----------------------------------------------
+static void UnityFailFloatArray(const struct _UnityDiff* diff, const _UU32 num_elements, const _UU32 worst, const UNITY_LINE_TYPE lineNumber)
+{
+    char text[UNITY_DIFF_TEXT_SIZE];
+    _UU32 length;
+
+    if (UnityFullDiff)
+    {
+        UnityDiffSummary(text, diff, num_elements, " Out Of Tolerance", ", Worst At");
+    }
+    else
+    {
+        length = UnityFormatNumberUnsigned(text, diff->Total);
+        length = UnityDiffAppend(text, length, " Of ");
+        length += UnityFormatNumberUnsigned(&text[length], num_elements);
+        UnityDiffAppend(text, length, " Out Of Tolerance, Worst At");
+    }
+
+    UnityTestResultsFailBegin(lineNumber);
+    UnityAddDetail(text);
+    UnityAddNumber(UNITY_FIELD_ELEMENT, (_U_SINT)worst, UNITY_DISPLAY_STYLE_UINT);
+}
+#endif
+
+#ifndef UNITY_EXCLUDE_FLOAT
+//-----------------------------------------------
+/// non-zero if an element of the block may be out of tolerance (NaNs and infinities always may be)
+static int UnityFloatBlockSuspect(const _UF* expected, const _UF* actual, const _UU32 count, const _UF tolerance, const UNITY_TOLERANCE_T mode)
+{
+    int suspect = 0;
+    _UU32 i = 0;
+    _UF diff, limit;
+
+    if (mode == UNITY_TOLERANCE_ULP)
+    {
+#ifdef UNITY_SIMD_SSE2
+        // a block with a tail too short for the kernel is left to the exact check
+        if ((sizeof(_UF) == sizeof(float)) && ((count & 3u) == 0) && (tolerance >= 0))
+        {
+            return UnitySuspectSse2FloatUlp((const float*)expected, (const float*)actual, count,
+                                            (tolerance < (_UF)2147483647.0) ? (_US32)tolerance : (_US32)2147483647);
+        }
+#endif
+        return 1;
+    }
+
+#ifdef UNITY_SIMD_SSE2
+    if (sizeof(_UF) == sizeof(float))
+    {
+        i = count & ~3u;
+        suspect = UnitySuspectSse2Float((const float*)expected, (const float*)actual, i, (float)tolerance, mode == UNITY_TOLERANCE_RELATIVE);
+    }
+#endif
+    for (; i < count; i++)
+    {
+        diff = expected[i] - actual[i];
+        diff = (diff < 0) ? -diff : diff;
+        limit = tolerance;
+        if (mode == UNITY_TOLERANCE_RELATIVE)
+        {
+            limit = (expected[i] < 0) ? -expected[i] : expected[i];
+            limit *= tolerance;
+        }
+        // x - x is 0 only for finite x
+        suspect |= !((diff <= limit) && ((expected[i] - expected[i]) == (actual[i] - actual[i])));
+    }
+    return suspect;
+}
+
+//-----------------------------------------------
+/// 0 if actual is within tolerance of expected, otherwise how badly it missed
+static double UnityFloatMiss(const _UF expected, const _UF actual, const _UF tolerance, const UNITY_TOLERANCE_T mode)
+{
+    unsigned long long ordinal_exp, ordinal_act, ulps;
+    _UF diff, magnitude;
+
+    if ((expected != expected) || (actual != actual))
+        return ((expected != expected) && (actual != actual)) ? 0.0 : UNITY_FLOAT_MISS_SPECIAL;
+    if (((expected - expected) != 0) || ((actual - actual) != 0))
+        return (expected == actual) ? 0.0 : UNITY_FLOAT_MISS_SPECIAL;
+
+    if (mode == UNITY_TOLERANCE_ULP)
+    {
+        ordinal_exp = UnityFloatOrdinal(&expected, sizeof(_UF));
+        ordinal_act = UnityFloatOrdinal(&actual, sizeof(_UF));
+        ulps = (ordinal_exp > ordinal_act) ? (ordinal_exp - ordinal_act) : (ordinal_act - ordinal_exp);
+        return ((double)ulps > (double)tolerance) ? (double)ulps : 0.0;
+    }
+
+    diff = expected - actual;
+    diff = (diff < 0) ? -diff : diff;
+    if (mode == UNITY_TOLERANCE_ABSOLUTE)
+        return (diff > tolerance) ? (double)diff : 0.0;
+
+    magnitude = (expected < 0) ? -expected : expected;
+    if (diff <= tolerance * magnitude)
+        return 0.0;
+    return (magnitude > 0) ? ((double)diff / (double)magnitude) : UNITY_FLOAT_MISS_SPECIAL;
+}
+
+//-----------------------------------------------
+void UnityAssertEqualFloatArray(const _UF* expected,
+                                const _UF* actual,
+                                const _UU32 num_elements,
+                                const char* msg,
+                                const UNITY_LINE_TYPE lineNumber)
+{
+    UnityAssertFloatArrayWithin((_UF)UNITY_FLOAT_PRECISION, UNITY_TOLERANCE_RELATIVE, expected, actual, num_elements, msg, lineNumber);
+}
+
+//-----------------------------------------------
+/// NaN only matches NaN and an infinity only itself; a failure names the worst element and how many missed
+void UnityAssertFloatArrayWithin(const _UF tolerance,
+                                 const UNITY_TOLERANCE_T mode,
+                                 const _UF* expected,
+                                 const _UF* actual,
+                                 const _UU32 num_elements,
+                                 const char* msg,
+                                 const UNITY_LINE_TYPE lineNumber)
+{
+    const _UF tol = (tolerance < 0) ? -tolerance : tolerance;
+    struct _UnityDiff diff;
+    _UU32 worst = 0;
+    _UU32 block, i, end;
+    double miss, worst_miss = 0.0;
+    UNITY_SKIP_EXECUTION;
+
+    if (num_elements == 0)
+    {
+        UnityTestResultsFailBegin(lineNumber);
+        UnityAddDetail(UnityStrPointless);
+        UnityAddMsgIfSpecified(msg);
+        UNITY_FAIL_AND_BAIL;
+    }
+
+    if (UnityCheckArraysForNull((void*)expected, (void*)actual, lineNumber, msg) == 1)
+        return;
+
+    memset(&diff, 0, sizeof(diff));
+    for (block = 0; block < num_elements; block += UNITY_FLOAT_BLOCK)
+    {
+        end = ((num_elements - block) < UNITY_FLOAT_BLOCK) ? num_elements : (block + UNITY_FLOAT_BLOCK);
+        if (!UnityFloatBlockSuspect(&expected[block], &actual[block], end - block, tol, mode))
+            continue;
+
+        for (i = block; i < end; i++)
+        {
+            miss = UnityFloatMiss(expected[i], actual[i], tol, mode);
+            if (miss > 0.0)
+            {
+                UnityDiffAdd(&diff, i, i);
+                if (miss > worst_miss)
+                {
+                    worst_miss = miss;
+                    worst = i;
+                }
+            }
+        }
+    }
+
+    if (diff.Total > 0)
+    {
+        UnityFailFloatArray(&diff, num_elements, worst, lineNumber);
+#ifdef UNITY_FLOAT_VERBOSE
+        UnityAddFloat(UNITY_FIELD_EXPECTED, expected[worst]);
+        UnityAddFloat(UNITY_FIELD_ACTUAL, actual[worst]);
+#else
+        UnityAddDetail(UnityStrDelta);
+#endif
+        UnityAddMsgIfSpecified(msg);
+        UNITY_FAIL_AND_BAIL;
+    }
+}
+
+//-----------------------------------------------
+void UnityAssertFloatsWithin(const _UF delta,
+                             const _UF expected,
+                             const _UF actual,
+                             const char* msg,
+                             const UNITY_LINE_TYPE lineNumber)
+{
+    _UF diff = actual - expected;
+    _UF pos_delta = delta;
+    UNITY_SKIP_EXECUTION;
+
+    if (diff < 0)
+    {
+        diff = 0.0f - diff;
+    }
+    if (pos_delta < 0)
+    {
+        pos_delta = 0.0f - pos_delta;
+    }
+
+    if (pos_delta < diff)
+    {
+        UnityTestResultsFailBegin(lineNumber);
+#ifdef UNITY_FLOAT_VERBOSE
+        UnityAddFloat(UNITY_FIELD_EXPECTED, expected);
+        UnityAddFloat(UNITY_FIELD_ACTUAL, actual);
+#else
+        UnityAddDetail(UnityStrDelta);
+#endif
+        UnityAddMsgIfSpecified(msg);
+        UNITY_FAIL_AND_BAIL;
+    }
+}
+
+#endif //not UNITY_EXCLUDE_FLOAT
+
+#ifndef UNITY_EXCLUDE_DOUBLE
+//-----------------------------------------------
+/// non-zero if an element of the block may be out of tolerance (NaNs and infinities always may be)
+static int UnityDoubleBlockSuspect(const _UD* expected, const _UD* actual, const _UU32 count, const _UD tolerance, const UNITY_TOLERANCE_T mode)
+{
+    int suspect = 0;
+    _UU32 i = 0;
+    _UD diff, limit;
+
+    if (mode == UNITY_TOLERANCE_ULP)
+        return 1;
+
+#ifdef UNITY_SIMD_SSE2
+    if (sizeof(_UD) == sizeof(double))
+    {
+        i = count & ~1u;
+        suspect = UnitySuspectSse2Double((const double*)expected, (const double*)actual, i, (double)tolerance, mode == UNITY_TOLERANCE_RELATIVE);
+    }
+#endif
+    for (; i < count; i++)
+    {
+        diff = expected[i] - actual[i];
+        diff = (diff < 0) ? -diff : diff;
+        limit = tolerance;
+        if (mode == UNITY_TOLERANCE_RELATIVE)
+        {
+            limit = (expected[i] < 0) ? -expected[i] : expected[i];
+            limit *= tolerance;
+        }
+        // x - x is 0 only for finite x
+        suspect |= !((diff <= limit) && ((expected[i] - expected[i]) == (actual[i] - actual[i])));
+    }
+    return suspect;
+}
+
+//-----------------------------------------------
+/// 0 if actual is within tolerance of expected, otherwise how badly it missed
+static double UnityDoubleMiss(const _UD expected, const _UD actual, const _UD tolerance, const UNITY_TOLERANCE_T mode)
+{
+    unsigned long long ordinal_exp, ordinal_act, ulps;
+    _UD diff, magnitude;
+
+    if ((expected != expected) || (actual != actual))
+        return ((expected != expected) && (actual != actual)) ? 0.0 : UNITY_FLOAT_MISS_SPECIAL;
+    if (((expected - expected) != 0) || ((actual - actual) != 0))
+        return (expected == actual) ? 0.0 : UNITY_FLOAT_MISS_SPECIAL;
+
+    if (mode == UNITY_TOLERANCE_ULP)
+    {
+        ordinal_exp = UnityFloatOrdinal(&expected, sizeof(_UD));
+        ordinal_act = UnityFloatOrdinal(&actual, sizeof(_UD));
+        ulps = (ordinal_exp > ordinal_act) ? (ordinal_exp - ordinal_act) : (ordinal_act - ordinal_exp);
+        return ((double)ulps > (double)tolerance) ? (double)ulps : 0.0;
+    }
+
+    diff = expected - actual;
+    diff = (diff < 0) ? -diff : diff;
+    if (mode == UNITY_TOLERANCE_ABSOLUTE)
+        return (diff > tolerance) ? (double)diff : 0.0;
+
+    magnitude = (expected < 0) ? -expected : expected;
+    if (diff <= tolerance * magnitude)
+        return 0.0;
+    return (magnitude > 0) ? ((double)diff / (double)magnitude) : UNITY_FLOAT_MISS_SPECIAL;
+}
+
+//-----------------------------------------------
+void UnityAssertEqualDoubleArray(const _UD* expected,
+                                 const _UD* actual,
+                                 const _UU32 num_elements,
+                                 const char* msg,
+                                 const UNITY_LINE_TYPE lineNumber)
+{
+    UnityAssertDoubleArrayWithin((_UD)UNITY_DOUBLE_PRECISION, UNITY_TOLERANCE_RELATIVE, expected, actual, num_elements, msg, lineNumber);
+}
+
+//-----------------------------------------------
+void UnityAssertDoubleArrayWithin(const _UD tolerance,
+                                  const UNITY_TOLERANCE_T mode,
+                                  const _UD* expected,
+                                  const _UD* actual,
+                                  const _UU32 num_elements,
+                                  const char* msg,
+                                  const UNITY_LINE_TYPE lineNumber)
+{
+    const _UD tol = (tolerance < 0) ? -tolerance : tolerance;
+    struct _UnityDiff diff;
+    _UU32 worst = 0;
+    _UU32 block, i, end;
+    double miss, worst_miss = 0.0;
+    UNITY_SKIP_EXECUTION;
+
+    if (num_elements == 0)
+    {
+        UnityTestResultsFailBegin(lineNumber);
+        UnityAddDetail(UnityStrPointless);
+        UnityAddMsgIfSpecified(msg);
+        UNITY_FAIL_AND_BAIL;
+    }
+
+    if (UnityCheckArraysForNull((void*)expected, (void*)actual, lineNumber, msg) == 1)
+        return;
+
+    memset(&diff, 0, sizeof(diff));
+    for (block = 0; block < num_elements; block += UNITY_FLOAT_BLOCK)
+    {
+        end = ((num_elements - block) < UNITY_FLOAT_BLOCK) ? num_elements : (block + UNITY_FLOAT_BLOCK);
+        if (!UnityDoubleBlockSuspect(&expected[block], &actual[block], end - block, tol, mode))
+            continue;
+
+        for (i = block; i < end; i++)
+        {
+            miss = UnityDoubleMiss(expected[i], actual[i], tol, mode);
+            if (miss > 0.0)
+            {
+                UnityDiffAdd(&diff, i, i);
+                if (miss > worst_miss)
+                {
+                    worst_miss = miss;
+                    worst = i;
+                }
+            }
+        }
+    }
+
+    if (diff.Total > 0)
+    {
+        UnityFailFloatArray(&diff, num_elements, worst, lineNumber);
+#ifdef UNITY_DOUBLE_VERBOSE
+        UnityAddFloat(UNITY_FIELD_EXPECTED, (float)expected[worst]);
+        UnityAddFloat(UNITY_FIELD_ACTUAL, (float)actual[worst]);
+#else
+        UnityAddDetail(UnityStrDelta);
+#endif
+        UnityAddMsgIfSpecified(msg);
+        UNITY_FAIL_AND_BAIL;
+    }
+}
+
+//-----------------------------------------------
+void UnityAssertDoublesWithin(const _UD delta,
+                              const _UD expected,
+                              const _UD actual,
+                              const char* msg,
+                              const UNITY_LINE_TYPE lineNumber)
+{
+    _UD diff = actual - expected;
+    _UD pos_delta = delta;
+    UNITY_SKIP_EXECUTION;
+
+    if (diff < 0)
+    {
+        diff = 0.0f - diff;
+    }
+    if (pos_delta < 0)
+    {
+        pos_delta = 0.0f - pos_delta;
+    }
+
+    if (pos_delta < diff)
+    {
+        UnityTestResultsFailBegin(lineNumber);
+#ifdef UNITY_DOUBLE_VERBOSE
+        UnityAddFloat(UNITY_FIELD_EXPECTED, (float)expected);
+        UnityAddFloat(UNITY_FIELD_ACTUAL, (float)actual);
+#else
+        UnityAddDetail(UnityStrDelta);
+#endif
+        UnityAddMsgIfSpecified(msg);
+        UNITY_FAIL_AND_BAIL;
+    }
+}
+
+#endif // not UNITY_EXCLUDE_DOUBLE
+
+//-----------------------------------------------
+void UnityAssertNumbersWithin( const _U_SINT delta,
+                               const _U_SINT expected,
+                               const _U_SINT actual,
+                               const char* msg,
+                               const UNITY_LINE_TYPE lineNumber,
+                               const UNITY_DISPLAY_STYLE_T style)
+{
+    int outside;
+
+    if ((style & UNITY_DISPLAY_RANGE_INT) == UNITY_DISPLAY_RANGE_INT)
+    {
+        if (actual > expected)
+          outside = ((actual - expected) > delta);
+        else
+          outside = ((expected - actual) > delta);
+    }
+    else
+    {
+        if ((_U_UINT)actual > (_U_UINT)expected)
+            outside = ((_U_UINT)(actual - expected) > (_U_UINT)delta);
+        else
+            outside = ((_U_UINT)(expected - actual) > (_U_UINT)delta);
+    }
+
+    if (outside)
+    {
+        UnityFailNumbersWithin(delta, expected, actual, msg, lineNumber, style);
+    }
+}
+
+//-----------------------------------------------
+void UnityFailNumbersWithin( const _U_SINT delta,
+                             const _U_SINT expected,
+                             const _U_SINT actual,
+                             const char* msg,
+                             const UNITY_LINE_TYPE lineNumber,
+                             const UNITY_DISPLAY_STYLE_T style)
+{
+    UNITY_SKIP_EXECUTION;
+
+    UnityTestResultsFailBegin(lineNumber);
+    UnityAddNumber(UNITY_FIELD_DELTA, delta, style);
+    UnityAddNumber(UNITY_FIELD_EXPECTED, expected, style);
+    UnityAddNumber(UNITY_FIELD_ACTUAL, actual, style);
+    UnityAddMsgIfSpecified(msg);
+    UNITY_FAIL_AND_BAIL;
+}
+
+//-----------------------------------------------
+// Strings are compared a chunk at a time: memchr finds how much of each is left
+// within the chunk without reading past a terminator, and the memory kernel
+// compares that much of both
+#define UNITY_STRING_CHUNK (4096)
+
+//-----------------------------------------------
+static size_t UnityStringChunk(const char* string, const size_t limit)
+{
+    const char* end = (const char*)memchr(string, '\0', limit);
+    return (end != NULL) ? (size_t)(end - string) : limit;
+}
+
+//-----------------------------------------------
+/// offset of the first character two strings differ in, or of their shared terminator if they are equal;
+/// size if their first size characters are the same
+static size_t UnityFirstStringDifference(const char* expected, const char* actual, const size_t size)
+{
+    size_t offset = 0;
+    size_t limit, chunk, index;
+
+    while (offset < size)
+    {
+        limit = ((size - offset) < UNITY_STRING_CHUNK) ? (size - offset) : UNITY_STRING_CHUNK;
+        chunk = UnityStringChunk(&actual[offset], UnityStringChunk(&expected[offset], limit));
+        index = UnityFirstDifference(&expected[offset], &actual[offset], chunk);
+        if ((index < chunk) || (chunk < limit))
+            return offset + index;
+        offset += chunk;
+    }
+    return size;
+}
+
+//-----------------------------------------------
+/// the text of a string (of at most size characters) around offset, with "..." where it was cut; non-zero if nothing was
+static int UnityStringExcerpt(char* excerpt, const char* string, const size_t size, const size_t offset)
+{
+    const size_t start = (offset > UNITY_STRING_EXCERPT) ? (offset - UNITY_STRING_EXCERPT) : 0;
+    const size_t limit = ((size - offset) > UNITY_STRING_EXCERPT) ? (UNITY_STRING_EXCERPT + 1) : (size - offset);
+    const size_t after = UnityStringChunk(&string[offset], limit);
+    _UU32 length = 0;
+
+    if (start > 0)
+    {
+        memcpy(excerpt, "...", 3);
+        length = 3;
+    }
+    memcpy(&excerpt[length], &string[start], offset - start);
+    length += (_UU32)(offset - start);
+    if (after > UNITY_STRING_EXCERPT)
+    {
+        memcpy(&excerpt[length], &string[offset], UNITY_STRING_EXCERPT);
+        memcpy(&excerpt[length + UNITY_STRING_EXCERPT], "...", 3);
+        length += UNITY_STRING_EXCERPT + 3;
+    }
+    else
+    {
+        memcpy(&excerpt[length], &string[offset], after);
+        length += (_UU32)after;
+    }
+    excerpt[length] = '\0';
+    return (start == 0) && (after <= UNITY_STRING_EXCERPT);
+}
+
+//-----------------------------------------------
+/// the expected and actual strings, cut down to the text around the first difference when they are long
+static void UnityAddStringDifference(const char* expected, const char* actual, const size_t size, const size_t offset)
+{
+    char excerpt_exp[2 * UNITY_STRING_EXCERPT + 7];
+    char excerpt_act[2 * UNITY_STRING_EXCERPT + 7];
+    char text[UNITY_FIELD_TEXT_SIZE];
+    int whole;
+
+    whole = UnityStringExcerpt(excerpt_exp, expected, size, offset);
+    whole &= UnityStringExcerpt(excerpt_act, actual, size, offset);
+    if (!whole)
+    {
+        strcpy(text, "First Difference At Offset ");
+        UnityFormatNumberUnsigned(&text[27], (_U_UINT)offset);
+        UnityAddDetail(text);
+    }
+    UnityAddExpectedAndActualStrings(excerpt_exp, excerpt_act);
+}
+
+//-----------------------------------------------
+void UnityAssertEqualString(const char* expected,
+                            const char* actual,
+                            const char* msg,
+                            const UNITY_LINE_TYPE lineNumber)
+{
+    size_t offset = 0;
+    UNITY_SKIP_EXECUTION;
+
+    // if both pointers not null compare the strings
+    if (expected && actual)
+    {
+        offset = UnityFirstStringDifference(expected, actual, (size_t)-1);
+        if (expected[offset] != actual[offset])
+        {
+            Unity.CurrentTestFailed = 1;
+        }
+    }
+    else
+    { // handle case of one pointers being null (if both null, test should pass)
+        if (expected != actual)
+        {
+            Unity.CurrentTestFailed = 1;
+        }
+    }
+
+    if (Unity.CurrentTestFailed)
+    {
+        UnityTestResultsFailBegin(lineNumber);
+        if (expected && actual)
+        {
+            UnityAddStringDifference(expected, actual, (size_t)-1, offset);
+        }
+        else
+        {
+            UnityAddExpectedAndActualStrings(expected, actual);
+        }
+        UnityAddMsgIfSpecified(msg);
+        UNITY_FAIL_AND_BAIL;
+    }
+}
+
+//-----------------------------------------------
+void UnityAssertEqualStringLen(const char* expected,
+                               const char* actual,
+                               const _UU32 length,
+                               const char* msg,
+                               const UNITY_LINE_TYPE lineNumber)
+{
+    size_t offset;
+    UNITY_SKIP_EXECUTION;
+
+    if (UnityCheckArraysForNull((void*)expected, (void*)actual, lineNumber, msg) == 1)
+        return;
+
+    // at most length characters are compared, and strings that end together before then are equal
+    offset = UnityFirstStringDifference(expected, actual, length);
+    if ((offset < length) && (expected[offset] != actual[offset]))
+    {
+        UnityTestResultsFailBegin(lineNumber);
+        UnityAddStringDifference(expected, actual, length, offset);
+        UnityAddMsgIfSpecified(msg);
+        UNITY_FAIL_AND_BAIL;
+    }
+}
+
+//-----------------------------------------------
+void UnityAssertEqualStringArray( const char** expected,
+                                  const char** actual,
+                                  const _UU32 num_elements,
+                                  const char* msg,
+                                  const UNITY_LINE_TYPE lineNumber)
+{
+    _UU32 j = 0;
+    size_t offset = 0;
+    UNITY_SKIP_EXECUTION;
+
+    // if no elements, it's an error
+    if (num_elements == 0)
+    {
+        UnityTestResultsFailBegin(lineNumber);
+        UnityAddDetail(UnityStrPointless);
+        UnityAddMsgIfSpecified(msg);
+        UNITY_FAIL_AND_BAIL;
+    }
+
+    if (UnityCheckArraysForNull((void*)expected, (void*)actual, lineNumber, msg) == 1)
+        return;
+
+    do
+    {
+        // if both pointers not null compare the strings
+        if (expected[j] && actual[j])
+        {
+            offset = UnityFirstStringDifference(expected[j], actual[j], (size_t)-1);
+            if (expected[j][offset] != actual[j][offset])
+            {
+                Unity.CurrentTestFailed = 1;
+            }
+        }
+        else
+        { // handle case of one pointers being null (if both null, test should pass)
+            if (expected[j] != actual[j])
+            {
+                Unity.CurrentTestFailed = 1;
+            }
+        }
+
+        if (Unity.CurrentTestFailed)
+        {
+            UnityTestResultsFailBegin(lineNumber);
+            if (num_elements > 1)
+            {
+                UnityAddNumber(UNITY_FIELD_ELEMENT, (_U_SINT)j, UNITY_DISPLAY_STYLE_UINT);
+            }
+            if (expected[j] && actual[j])
+            {
+                UnityAddStringDifference(expected[j], actual[j], (size_t)-1, offset);
+            }
+            else
+            {
+                UnityAddExpectedAndActualStrings((const char*)(expected[j]), (const char*)(actual[j]));
+            }
+            UnityAddMsgIfSpecified(msg);
+            UNITY_FAIL_AND_BAIL;
+        }
+    } while (++j < num_elements);
+}
+
+//-----------------------------------------------
+/// report every run of differing elements (or bytes, for a single element) between two memory blocks
+static void UnityFailMemoryDiff(const unsigned char* expected,
+                                const unsigned char* actual,
+                                const _UU32 length,
+                                const _UU32 num_elements,
+                                const size_t index,
+                                const char* msg,
+                                const UNITY_LINE_TYPE lineNumber)
+{
+    const _UU32 width = (num_elements > 1) ? length : 1;
+    const _UU32 count = (num_elements > 1) ? num_elements : length;
+    struct _UnityDiff diff;
+    char summary[UNITY_DIFF_TEXT_SIZE];
+    char last[UNITY_DIFF_TEXT_SIZE];
+    _UU32 text_length;
+    size_t last_index;
+
+    UnityDiffMemory(&diff, expected, actual, width, count);
+    UnityDiffSummary(summary, &diff, count, (num_elements > 1) ? " Elements Differ" : " Bytes Differ", ", First At");
+
+    // the last run ends on a differing element, so its first differing byte is there
+    last_index = (size_t)diff.LastElement * width;
+    while (expected[last_index] == actual[last_index])
+    {
+        last_index++;
+    }
+    text_length = UnityDiffAppend(last, 0, "Last At");
+    if (num_elements > 1)
+    {
+        text_length = UnityDiffAppend(last, text_length, UnityStrElement);
+        text_length += UnityFormatNumberUnsigned(&last[text_length], diff.LastElement);
+    }
+    text_length = UnityDiffAppend(last, text_length, UnityStrByte);
+    text_length += UnityFormatNumberUnsigned(&last[text_length], (_U_UINT)(last_index % length));
+    UnityDiffValues(last, text_length, expected[last_index], actual[last_index], UNITY_DISPLAY_STYLE_HEX8);
+
+    UnityTestResultsFailBegin(lineNumber);
+    UnityAddDetail(UnityStrMemory);
+    UnityAddDetail(summary);
+    if (num_elements > 1)
+    {
+        UnityAddNumber(UNITY_FIELD_ELEMENT, (_U_SINT)(index / length), UNITY_DISPLAY_STYLE_UINT);
+    }
+    UnityAddNumber(UNITY_FIELD_BYTE, (_U_SINT)(index % length), UNITY_DISPLAY_STYLE_UINT);
+    UnityAddNumber(UNITY_FIELD_EXPECTED, expected[index], UNITY_DISPLAY_STYLE_HEX8);
+    UnityAddNumber(UNITY_FIELD_ACTUAL, actual[index], UNITY_DISPLAY_STYLE_HEX8);
+    UnityAddDetail(last);
+    UnityAddMsgIfSpecified(msg);
+    UNITY_FAIL_AND_BAIL;
+}
+
+//-----------------------------------------------
+void UnityAssertEqualMemory( const void* expected,
+                             const void* actual,
+                             const _UU32 length,
+                             const _UU32 num_elements,
+                             const char* msg,
+                             const UNITY_LINE_TYPE lineNumber)
+{
+    const unsigned char* ptr_exp = (const unsigned char*)expected;
+    const unsigned char* ptr_act = (const unsigned char*)actual;
+    const size_t size = (size_t)length * num_elements;
+    size_t index;
+    UNITY_SKIP_EXECUTION;
+
+    if ((num_elements == 0) || (length == 0))
+    {
+        UnityTestResultsFailBegin(lineNumber);
+        UnityAddDetail(UnityStrPointless);
+        UnityAddMsgIfSpecified(msg);
+        UNITY_FAIL_AND_BAIL;
+    }
+
+    if (UnityCheckArraysForNull((void*)expected, (void*)actual, lineNumber, msg) == 1)
+        return;
+
+    // compare the whole run of elements in one pass, then work out where the mismatch was
+    index = UnityFirstDifference(ptr_exp, ptr_act, size);
+    if ((index < size) && UnityFullDiff)
+    {
+        UnityFailMemoryDiff(ptr_exp, ptr_act, length, num_elements, index, msg, lineNumber);
+    }
+    if (index < size)
+    {
+        UnityTestResultsFailBegin(lineNumber);
+        UnityAddDetail(UnityStrMemory);
+        if (num_elements > 1)
+        {
+            UnityAddNumber(UNITY_FIELD_ELEMENT, (_U_SINT)(index / length), UNITY_DISPLAY_STYLE_UINT);
+        }
+        UnityAddNumber(UNITY_FIELD_BYTE, (_U_SINT)(index % length), UNITY_DISPLAY_STYLE_UINT);
+        UnityAddNumber(UNITY_FIELD_EXPECTED, ptr_exp[index], UNITY_DISPLAY_STYLE_HEX8);
+        UnityAddNumber(UNITY_FIELD_ACTUAL, ptr_act[index], UNITY_DISPLAY_STYLE_HEX8);
+        UnityAddMsgIfSpecified(msg);
+        UNITY_FAIL_AND_BAIL;
+    }
+}
+
+//-----------------------------------------------
+// Test Selection
+//-----------------------------------------------
+// With more than one shard, a test only runs in the shard its file and name hash
+// to, so machines sharing a suite each run their part of it and no test twice.
+// Include and exclude patterns pick tests by name as well.  Tests that are not
+// run are not counted or reported either.
+
+_UU32 UnityShardIndex = 0;
+_UU32 UnityShardCount = 0;
+
+// A list of name patterns, compiled when it is given: plain names go in a hash
+// set and only patterns with wildcards are matched one by one
+#define UNITY_FILTER_SLOTS (UNITY_FILTER_MAX_PATTERNS * 2)
+
+struct _UnityFilter
+{
+    const char* Names[UNITY_FILTER_SLOTS];
+    _UU32 Hashes[UNITY_FILTER_SLOTS];
+    _UU32 NameCount;
+    const char* Globs[UNITY_FILTER_MAX_PATTERNS];
+    _UU32 GlobCount;
+    int Given;
+};
+
+static struct _UnityFilter UnityInclude;
+static struct _UnityFilter UnityExclude;
+static int UnityFiltering = 0;
+static int UnityFiltersRead = 0;
+
+// the patterns themselves, split apart
+static char  UnityFilterText[UNITY_FILTER_TEXT_SIZE];
+static _UU32 UnityFilterTextUsed = 0;
+
+//-----------------------------------------------
+/// read INDEX/COUNT, as given to --shard or UNITY_SHARD
+static int UnitySetShard(const char* text)
+{
+    const char* given = text;
+    char* end;
+    const unsigned long index = strtoul(text, &end, 10);
+    unsigned long count;
+
+    if ((end != text) && (*end == '/'))
+    {
+        text = end + 1;
+        count = strtoul(text, &end, 10);
+        if ((end != text) && (*end == '\0') && (count > 0) && (index < count) && (count <= 0xFFFFFFFFul))
+        {
+            UnityShardIndex = (_UU32)index;
+            UnityShardCount = (_UU32)count;
+            return 1;
+        }
+    }
+    UnityPrint("Unity: shard must be INDEX/COUNT with INDEX below COUNT, not ", UNITY_CHANNEL_CONSOLE);
+    UnityPrint(given, UNITY_CHANNEL_CONSOLE);
+    UNITY_PRINT_EOL;
+    return 0;
+}
+
+//-----------------------------------------------
+static _UU32 UnityNameHash(const char* name)
+{
+    _UU32 hash = 2166136261u;
+
+    for (; *name != '\0'; name++)
+    {
+        hash = (hash ^ (unsigned char)*name) * 16777619u;
+    }
+    return hash;
+}
+
+//-----------------------------------------------
+/// '*' matches any run of characters and '?' any one
+static int UnityGlobMatch(const char* pattern, const char* name)
+{
+    const char* star = NULL;
+    const char* resume = name;
+
+    while (*name != '\0')
+    {
+        if (*pattern == '*')
+        {
+            star = pattern++;
+            resume = name;
+        }
+        else if ((*pattern == '?') || (*pattern == *name))
+        {
+            pattern++;
+            name++;
+        }
+        else if (star != NULL)
+        {
+            // let the last star take one more character and try again
+            pattern = star + 1;
+            name = ++resume;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+    while (*pattern == '*')
+    {
+        pattern++;
+    }
+    return (*pattern == '\0');
+}
+
+//-----------------------------------------------
+static int UnityFilterAdd(struct _UnityFilter* filter, const char* pattern)
+{
+    const _UU32 hash = UnityNameHash(pattern);
+    _UU32 slot = hash % UNITY_FILTER_SLOTS;
+
+    if ((strchr(pattern, '*') != NULL) || (strchr(pattern, '?') != NULL))
+    {
+        if (filter->GlobCount == UNITY_FILTER_MAX_PATTERNS)
+            return 0;
+        filter->Globs[filter->GlobCount++] = pattern;
+        return 1;
+    }
+
+    while (filter->Names[slot] != NULL)
+    {
+        if ((filter->Hashes[slot] == hash) && (strcmp(filter->Names[slot], pattern) == 0))
+            return 1;
+        slot = (slot + 1) % UNITY_FILTER_SLOTS;
+    }
+    if (filter->NameCount == UNITY_FILTER_MAX_PATTERNS)
+        return 0;
+    filter->Names[slot] = pattern;
+    filter->Hashes[slot] = hash;
+    filter->NameCount++;
+    return 1;
+}
+
+//-----------------------------------------------
+/// add comma separated patterns, as given to --include/--exclude or UNITY_INCLUDE/UNITY_EXCLUDE
+static int UnityAddPatterns(struct _UnityFilter* filter, const char* patterns)
+{
+    const size_t length = strlen(patterns);
+    char* pattern = &UnityFilterText[UnityFilterTextUsed];
+    char* end;
+    int ok = 1;
+
+    if (length >= sizeof(UnityFilterText) - UnityFilterTextUsed)
+    {
+        ok = 0;
+    }
+    else
+    {
+        memcpy(pattern, patterns, length + 1);
+        UnityFilterTextUsed += (_UU32)length + 1;
+        for (; ok && (pattern != NULL); pattern = (end != NULL) ? end + 1 : NULL)
+        {
+            end = strchr(pattern, ',');
+            if (end != NULL)
+                *end = '\0';
+            if (pattern[0] != '\0')
+                ok = UnityFilterAdd(filter, pattern);
+        }
+    }
+    if (!ok)
+    {
+        UnityPrint("Unity: too many test name patterns, some were dropped", UNITY_CHANNEL_CONSOLE);
+        UNITY_PRINT_EOL;
+    }
+    filter->Given = 1;
+    UnityFiltering = ((UnityInclude.NameCount + UnityInclude.GlobCount + UnityExclude.NameCount + UnityExclude.GlobCount) > 0);
+    return ok;
+}
+
+//-----------------------------------------------
+static int UnityFilterMatch(const struct _UnityFilter* filter, const char* name, const _UU32 hash)
+{
+    _UU32 slot = hash % UNITY_FILTER_SLOTS;
+    _UU32 i;
+
+    if (filter->NameCount > 0)
+    {
+        while (filter->Names[slot] != NULL)
+        {
+            if ((filter->Hashes[slot] == hash) && (strcmp(filter->Names[slot], name) == 0))
+                return 1;
+            slot = (slot + 1) % UNITY_FILTER_SLOTS;
+        }
+    }
+    for (i = 0; i < filter->GlobCount; i++)
+    {
+        if (UnityGlobMatch(filter->Globs[i], name))
+            return 1;
+    }
+    return 0;
+}
+
+//-----------------------------------------------
+/// patterns from the environment, for the lists not given on the command line
+static void UnityReadFilters(void)
+{
+    const char* include = getenv("UNITY_INCLUDE");
+    const char* exclude = getenv("UNITY_EXCLUDE");
+
+    if (UnityFiltersRead)
+        return;
+    UnityFiltersRead = 1;
+    if (!UnityInclude.Given && (include != NULL) && (include[0] != '\0'))
+        UnityAddPatterns(&UnityInclude, include);
+    if (!UnityExclude.Given && (exclude != NULL) && (exclude[0] != '\0'))
+        UnityAddPatterns(&UnityExclude, exclude);
+}
+
+//-----------------------------------------------
+/// the value of an option given as --name=value or --name value, or NULL
+static const char* UnityOptionValue(const char* option, int argc, char* argv[], int* i)
+{
+    const size_t length = strlen(option);
+
+    if (strncmp(argv[*i], option, length) != 0)
+        return NULL;
+    if (argv[*i][length] == '=')
+        return &argv[*i][length + 1];
+    if ((argv[*i][length] == '\0') && (*i + 1 < argc))
+        return argv[++*i];
+    return NULL;
+}
+
+//-----------------------------------------------
+int UnityParseOptions(int argc, char* argv[])
+{
+    const char* value;
+    int ok = 1;
+    int i;
+
+    for (i = 1; i < argc; i++)
+    {
+        if ((value = UnityOptionValue("--shard", argc, argv, &i)) != NULL)
+        {
+            ok &= UnitySetShard(value);
+        }
+        else if ((value = UnityOptionValue("--include", argc, argv, &i)) != NULL)
+        {
+            ok &= UnityAddPatterns(&UnityInclude, value);
+        }
+        else if ((value = UnityOptionValue("--exclude", argc, argv, &i)) != NULL)
+        {
+            ok &= UnityAddPatterns(&UnityExclude, value);
+        }
+        else if ((value = UnityOptionValue("--history", argc, argv, &i)) != NULL)
+        {
+            Unity.HistoryFile = value;
+        }
+#ifdef UNITY_SUPPORT_CACHE
+        else if ((value = UnityOptionValue("--cache", argc, argv, &i)) != NULL)
+        {
+            Unity.CacheDir = value;
+        }
+        else if ((value = UnityOptionValue("--cache-inputs", argc, argv, &i)) != NULL)
+        {
+            Unity.CacheInputs = value;
+        }
+#endif
+    }
+    return ok;
+}
+
+//-----------------------------------------------
+/// FNV-1a over the file and test names, the same on every machine and build
+static _UU32 UnityShardHash(const char* file, const char* name)
+{
+    _UU32 hash = 2166136261u;
+
+    for (; (file != NULL) && (*file != '\0'); file++)
+    {
+        hash = (hash ^ (unsigned char)*file) * 16777619u;
+    }
+    hash = (hash ^ (unsigned char)':') * 16777619u;
+    for (; (name != NULL) && (*name != '\0'); name++)
+    {
+        hash = (hash ^ (unsigned char)*name) * 16777619u;
+    }
+    return hash;
+}
+
+//-----------------------------------------------
+static int UnityTestSelected(const char* name)
+{
+    // a run played back from the cache runs nothing
+    if (UNITY_CACHE_REPLAYING())
+        return 0;
+    if (UnityFiltering)
+    {
+        const _UU32 hash = UnityNameHash(name);
+        if ((UnityInclude.NameCount + UnityInclude.GlobCount > 0) && !UnityFilterMatch(&UnityInclude, name, hash))
+            return 0;
+        if (UnityFilterMatch(&UnityExclude, name, hash))
+            return 0;
+    }
+    if (UnityShardCount <= 1)
+        return 1;
+    return (UnityShardHash(Unity.TestFile, name) % UnityShardCount) == UnityShardIndex;
+}
+
+#if defined(UNITY_SUPPORT_THREADS) || defined(UNITY_SUPPORT_FORK)
+//-----------------------------------------------
+/// point tests at the entries of the table to run, copied out when some are left out; returns how many
+static _UU32 UnitySelectTests(const UnityTestEntry** tests, const _UU32 total)
+{
+    UnityTestEntry* selected;
+    _UU32 count = 0;
+    _UU32 i;
+
+    if (!UnityFiltering && (UnityShardCount <= 1) && !UNITY_CACHE_REPLAYING())
+        return total;
+    selected = (UnityTestEntry*)malloc((total ? total : 1) * sizeof(UnityTestEntry));
+    if (selected == NULL)
+        return total;
+
+    for (i = 0; i < total; i++)
+    {
+        if (UnityTestSelected((*tests)[i].FuncName))
+            selected[count++] = (*tests)[i];
+    }
+    *tests = selected;
+    return count;
+}
+#endif
+
+//-----------------------------------------------
+// Test History
+//-----------------------------------------------
+// With Unity.HistoryFile set, UnityEnd() keeps each test's last status and
+// duration there, and the next parallel or forked run starts the tests that
+// failed or are new first, then the slowest.  Ties keep their table order, so
+// a history always gives the same order, and results are reported in table
+// order whichever order the tests ran in.
+
+// One line of the history file, "PASS|FAIL|IGNORE|TIMEOUT <microseconds> <test> <file>",
+// with the file last as the only field that may hold spaces
+struct _UnityHistoryEntry
+{
+    const char* File;
+    const char* Name;
+    char* Copy;         // the strings of a test first seen in this run, or NULL
+    _UU32 Hash;
+    UNITY_RESULT_T Status;
+    unsigned long Micros;
+};
+
+static const char* UnityHistoryPath = NULL;
+static char* UnityHistoryText = NULL;
+static struct _UnityHistoryEntry* UnityHistory = NULL;
+static _UU32 UnityHistoryCount = 0;
+static _UU32 UnityHistoryCapacity = 0;
+static _UU32* UnityHistorySlots = NULL;  // open addressed, entry index + 1
+static _UU32 UnityHistorySlotCount = 0;
+
+//-----------------------------------------------
+/// the whole of a file, with a terminator after it; its length goes to length unless that is NULL
+static char* UnityReadFile(const char* path, size_t* length)
+{
+    FILE* file = fopen(path, "rb");
+    char* text = NULL;
+    size_t got;
+    long size;
+
+    if (file == NULL)
+        return NULL;
+    if ((fseek(file, 0, SEEK_END) == 0) && ((size = ftell(file)) >= 0) && (fseek(file, 0, SEEK_SET) == 0))
+    {
+        text = (char*)malloc((size_t)size + 1);
+        if (text != NULL)
+        {
+            got = fread(text, 1, (size_t)size, file);
+            text[got] = '\0';
+            if (length != NULL)
+                *length = got;
+        }
+    }
+    fclose(file);
+    return text;
+}
+
+//-----------------------------------------------
+static struct _UnityHistoryEntry* UnityFindHistory(const char* file, const char* name, const _UU32 hash)
+{
+    _UU32 slot;
+
+    if (UnityHistorySlotCount == 0)
+        return NULL;
+    for (slot = hash & (UnityHistorySlotCount - 1); UnityHistorySlots[slot] != 0; slot = (slot + 1) & (UnityHistorySlotCount - 1))
+    {
+        struct _UnityHistoryEntry* entry = &UnityHistory[UnityHistorySlots[slot] - 1];
+        if ((entry->Hash == hash) && (strcmp(entry->Name, name) == 0) && (strcmp(entry->File, file) == 0))
+            return entry;
+    }
+    return NULL;
+}
+
+//-----------------------------------------------
+/// append an entry, growing the table so it stays at most half full; NULL when out of memory
+static struct _UnityHistoryEntry* UnityAddHistory(const char* file, const char* name, const _UU32 hash)
+{
+    struct _UnityHistoryEntry* entry;
+    _UU32 i, slot;
+
+    if (UnityHistoryCount == UnityHistoryCapacity)
+    {
+        const _UU32 capacity = (UnityHistoryCapacity == 0) ? 64 : UnityHistoryCapacity * 2;
+        struct _UnityHistoryEntry* grown = (struct _UnityHistoryEntry*)realloc(UnityHistory, capacity * sizeof(*grown));
+        _UU32* slots = (_UU32*)calloc(capacity * 2, sizeof(*slots));
+
+        if ((grown == NULL) || (slots == NULL))
+        {
+            if (grown != NULL)
+                UnityHistory = grown;
+            free(slots);
+            return NULL;
+        }
+        UnityHistory = grown;
+        UnityHistoryCapacity = capacity;
+        free(UnityHistorySlots);
+        UnityHistorySlots = slots;
+        UnityHistorySlotCount = capacity * 2;
+        for (i = 0; i < UnityHistoryCount; i++)
+        {
+            for (slot = UnityHistory[i].Hash & (UnityHistorySlotCount - 1); UnityHistorySlots[slot] != 0; slot = (slot + 1) & (UnityHistorySlotCount - 1))
+                ;
+            UnityHistorySlots[slot] = i + 1;
+        }
+    }
+
+    entry = &UnityHistory[UnityHistoryCount++];
+    memset(entry, 0, sizeof(*entry));
+    entry->File = file;
+    entry->Name = name;
+    entry->Hash = hash;
+    for (slot = hash & (UnityHistorySlotCount - 1); UnityHistorySlots[slot] != 0; slot = (slot + 1) & (UnityHistorySlotCount - 1))
+        ;
+    UnityHistorySlots[slot] = UnityHistoryCount;
+    return entry;
+}
+
+//-----------------------------------------------
+static void UnityFreeHistory(void)
+{
+    _UU32 i;
+
+    for (i = 0; i < UnityHistoryCount; i++)
+    {
+        free(UnityHistory[i].Copy);
+    }
+    free(UnityHistory);
+    free(UnityHistorySlots);
+    free(UnityHistoryText);
+    UnityHistory = NULL;
+    UnityHistorySlots = NULL;
+    UnityHistoryText = NULL;
+    UnityHistoryCount = 0;
+    UnityHistoryCapacity = 0;
+    UnityHistorySlotCount = 0;
+    UnityHistoryPath = NULL;
+}
+
+//-----------------------------------------------
+/// load Unity.HistoryFile (or UNITY_HISTORY); lines that do not parse are dropped
+static void UnityReadHistory(void)
+{
+    const char* path = Unity.HistoryFile;
+    char* line;
+    char* next;
+
+    UnityFreeHistory();
+    if (path == NULL)
+        path = getenv("UNITY_HISTORY");
+    if ((path == NULL) || (path[0] == '\0'))
+        return;
+    UnityHistoryPath = path;
+
+    // no history yet is not an error; this run writes the first one
+    UnityHistoryText = UnityReadFile(path, NULL);
+    for (line = UnityHistoryText; line != NULL; line = next)
+    {
+        UNITY_RESULT_T status;
+        unsigned long micros;
+        char* name;
+        char* file;
+        struct _UnityHistoryEntry* entry;
+
+        next = strchr(line, '\n');
+        if (next != NULL)
+        {
+            if ((next > line) && (next[-1] == '\r'))
+                next[-1] = '\0';
+            *next++ = '\0';
+        }
+
+        if (strncmp(line, "PASS ", 5) == 0)
+            status = UNITY_RESULT_PASS;
+        else if (strncmp(line, "FAIL ", 5) == 0)
+            status = UNITY_RESULT_FAIL;
+        else if (strncmp(line, "IGNORE ", 7) == 0)
+            status = UNITY_RESULT_IGNORE;
+        else if (strncmp(line, "TIMEOUT ", 8) == 0)
+            status = UNITY_RESULT_TIMEOUT;
+        else
+            continue;
+        micros = strtoul(strchr(line, ' ') + 1, &name, 10);
+        if (*name++ != ' ')
+            continue;
+        file = strchr(name, ' ');
+        if ((file == NULL) || (file == name))
+            continue;
+        *file++ = '\0';
+
+        // a name listed twice keeps its last line, as the file is only ever written whole
+        entry = UnityFindHistory(file, name, UnityShardHash(file, name));
+        if (entry == NULL)
+            entry = UnityAddHistory(file, name, UnityShardHash(file, name));
+        if (entry == NULL)
+            break;
+        entry->Status = status;
+        entry->Micros = micros;
+    }
+}
+
+//-----------------------------------------------
+/// remember how a reported test went, for UnityEnd to write out
+static void UnityTrackHistory(const struct _UnityResult* result)
+{
+    const char* file = (result->File != NULL) ? result->File : "";
+    struct _UnityHistoryEntry* entry;
+    _UU32 hash;
+    size_t length;
+    char* copy;
+
+    if ((UnityHistoryPath == NULL) || (result->TestName == NULL))
+        return;
+
+    hash = UnityShardHash(file, result->TestName);
+    entry = UnityFindHistory(file, result->TestName, hash);
+    if (entry == NULL)
+    {
+        // the result may be gone by UnityEnd, so a test new to the history keeps its own names
+        length = strlen(result->TestName) + 1;
+        copy = (char*)malloc(length + strlen(file) + 1);
+        if (copy == NULL)
+            return;
+        memcpy(copy, result->TestName, length);
+        strcpy(copy + length, file);
+        entry = UnityAddHistory(copy + length, copy, hash);
+        if (entry == NULL)
+        {
+            free(copy);
+            return;
+        }
+        entry->Copy = copy;
+    }
+    entry->Status = result->Status;
+#ifdef UNITY_SUPPORT_TIMING
+    entry->Micros = (unsigned long)(UnityTimingTotal(&result->Timing) / 1000);
+#endif
+}
+
+//-----------------------------------------------
+/// replace the history file with this run's view of it, tests that did not run included
+static void UnityWriteHistory(void)
+{
+    static const char* const statuses[] = { "PASS", "FAIL", "IGNORE", "TIMEOUT" };
+    const size_t length = (UnityHistoryPath != NULL) ? strlen(UnityHistoryPath) : 0;
+    char* temporary;
+    FILE* file;
+    _UU32 i;
+    int ok;
+
+    if (UnityHistoryPath == NULL)
+        return;
+    temporary = (char*)malloc(length + sizeof(".tmp"));
+    if (temporary != NULL)
+    {
+        memcpy(temporary, UnityHistoryPath, length);
+        memcpy(temporary + length, ".tmp", sizeof(".tmp"));
+        file = fopen(temporary, "w");
+        ok = (file != NULL);
+        for (i = 0; ok && (i < UnityHistoryCount); i++)
+        {
+            const struct _UnityHistoryEntry* entry = &UnityHistory[i];
+            ok = (fprintf(file, "%s %lu %s %s\n", statuses[entry->Status], entry->Micros, entry->Name, entry->File) > 0);
+        }
+        if (file != NULL)
+            ok &= (fclose(file) == 0);
+        // renamed into place, so an interrupted write never leaves half a history behind
+        if (!ok || (rename(temporary, UnityHistoryPath) != 0))
+        {
+            remove(temporary);
+            UnityPrint("History Could Not Be Written: ", UNITY_CHANNEL_CONSOLE);
+            UnityPrint(UnityHistoryPath, UNITY_CHANNEL_CONSOLE);
+            UNITY_PRINT_EOL;
+        }
+        free(temporary);
+    }
+    UnityFreeHistory();
+}
+
+#if defined(UNITY_SUPPORT_THREADS) || defined(UNITY_SUPPORT_FORK)
+// What the order of a table is decided on
+struct _UnityHistoryRank
+{
+    _UU32 Index;
+    int Failed;
+    unsigned long Micros;
+};
+
+//-----------------------------------------------
+static int UnityCompareRanks(const void* left, const void* right)
+{
+    const struct _UnityHistoryRank* a = (const struct _UnityHistoryRank*)left;
+    const struct _UnityHistoryRank* b = (const struct _UnityHistoryRank*)right;
+
+    if (a->Failed != b->Failed)
+        return b->Failed - a->Failed;
+    if (a->Micros != b->Micros)
+        return (a->Micros < b->Micros) ? 1 : -1;
+    return (a->Index < b->Index) ? -1 : 1;
+}
+
+//-----------------------------------------------
+/// the order to run a table in: tests that failed (or are new) first, then the slowest, ties in table order.
+/// NULL without a history, to run it as written
+static _UU32* UnityOrderTests(const UnityTestEntry* tests, const _UU32 count)
+{
+    const char* file = (Unity.TestFile != NULL) ? Unity.TestFile : "";
+    struct _UnityHistoryRank* ranks;
+    _UU32* order;
+    _UU32 i;
+
+    if ((UnityHistoryPath == NULL) || (count < 2))
+        return NULL;
+    ranks = (struct _UnityHistoryRank*)malloc(count * sizeof(*ranks));
+    order = (_UU32*)malloc(count * sizeof(*order));
+    if ((ranks == NULL) || (order == NULL))
+    {
+        free(ranks);
+        free(order);
+        return NULL;
+    }
+
+    for (i = 0; i < count; i++)
+    {
+        const struct _UnityHistoryEntry* entry = UnityFindHistory(file, tests[i].FuncName, UnityShardHash(file, tests[i].FuncName));
+        ranks[i].Index = i;
+        // a test with no history has never been seen to pass
+        ranks[i].Failed = (entry == NULL) || (entry->Status == UNITY_RESULT_FAIL) || (entry->Status == UNITY_RESULT_TIMEOUT);
+        ranks[i].Micros = (entry != NULL) ? entry->Micros : 0;
+    }
+    qsort(ranks, count, sizeof(*ranks), UnityCompareRanks);
+    for (i = 0; i < count; i++)
+    {
+        order[i] = ranks[i].Index;
+    }
+    free(ranks);
+    return order;
+}
+#endif
+
+#ifdef UNITY_SUPPORT_CACHE
+//-----------------------------------------------
+// Result Cache
+//-----------------------------------------------
+// A run is keyed by a hash of the test executable, the input files it was
+// given and the options that change what it runs.  A finished run stores its
+// console output, its report and UnityEnd's return value under that key, in
+// <dir>/<first two hex digits>/<key>; a later run with the same key runs no
+// tests and has UnityEnd play them back.  Entries are renamed into place whole,
+// and once the directory holds more than UNITY_CACHE_SIZE bytes the entries
+// least recently used are removed.
+//
+// The report is kept as one segment per report file it went to: the test file
+// it is named after, a NUL, the length of the data in UNITY_CACHE_DIGITS
+// decimal digits, then the data.
+
+#define UNITY_CACHE_HEADER "UNITY CACHE 2"
+#define UNITY_CACHE_DIGITS 20
+
+// Output kept while the run is recorded, one growing buffer per channel
+struct _UnityCapture
+{
+    char* Data;
+    size_t Used;
+    size_t Size;
+};
+
+static const char* UnityCacheDir = NULL;
+static char UnityCacheKey[17];
+static int UnityCacheRecording = 0;
+static struct _UnityCapture UnityCaptures[2];   // indexed by channel
+static char* UnityCacheEntry = NULL;            // the entry being played back
+static size_t UnityCacheConsole = 0;
+static size_t UnityCacheReport = 0;
+static int UnityCacheResult = 0;
+static size_t UnityCacheLengthAt = 0;           // where the open segment's length goes, 0 if none is open
+
+//-----------------------------------------------
+static int UnityCacheReplaying(void)
+{
+    return (UnityCacheEntry != NULL);
+}
+
+//-----------------------------------------------
+static void UnityCacheForget(void)
+{
+    free(UnityCaptures[0].Data);
+    free(UnityCaptures[1].Data);
+    memset(UnityCaptures, 0, sizeof(UnityCaptures));
+    UnityCacheLengthAt = 0;
+    free(UnityCacheEntry);
+    UnityCacheEntry = NULL;
+    UnityCacheRecording = 0;
+    UnityCacheDir = NULL;
+}
+
+//-----------------------------------------------
+/// append to a capture; a run with more output than the cache can hold is not recorded
+static void UnityCacheAppend(struct _UnityCapture* capture, const char* text, const size_t length)
+{
+    if (!UnityCacheRecording)
+        return;
+    if (capture->Size - capture->Used < length)
+    {
+        size_t size = (capture->Size == 0) ? 4096 : capture->Size;
+        char* grown;
+
+        while (size - capture->Used < length)
+            size *= 2;
+        grown = (size <= (size_t)UNITY_CACHE_SIZE) ? (char*)realloc(capture->Data, size) : NULL;
+        if (grown == NULL)
+        {
+            UnityCacheRecording = 0;
+            return;
+        }
+        capture->Data = grown;
+        capture->Size = size;
+    }
+    memcpy(&capture->Data[capture->Used], text, length);
+    capture->Used += length;
+}
+
+//-----------------------------------------------
+/// fill in the length of the open report segment
+static void UnityCacheEndSegment(void)
+{
+    char digits[UNITY_CACHE_DIGITS + 1];
+
+    if (!UnityCacheRecording || (UnityCacheLengthAt == 0))
+        return;
+    sprintf(digits, "%0*lu", UNITY_CACHE_DIGITS, (unsigned long)(UnityCaptures[0].Used - UnityCacheLengthAt - UNITY_CACHE_DIGITS));
+    memcpy(&UnityCaptures[0].Data[UnityCacheLengthAt], digits, UNITY_CACHE_DIGITS);
+    UnityCacheLengthAt = 0;
+}
+
+//-----------------------------------------------
+/// start a report segment for the report named after file
+static void UnityCacheSegment(const char* file)
+{
+    static const char zeros[UNITY_CACHE_DIGITS] = {0};
+
+    if (!UnityCacheRecording)
+        return;
+    UnityCacheEndSegment();
+    UnityCacheAppend(&UnityCaptures[0], file, strlen(file) + 1);
+    UnityCacheLengthAt = UnityCaptures[0].Used;
+    UnityCacheAppend(&UnityCaptures[0], zeros, sizeof(zeros));
+}
+
+//-----------------------------------------------
+/// copy output into the recording
+static void UnityCacheKeep(const char* text, const size_t length, const _US32 index)
+{
+    if (!UnityCacheRecording)
+        return;
+    if (index == UNITY_CHANNEL_CONSOLE)
+    {
+        UnityCacheAppend(&UnityCaptures[1], text, length);
+        return;
+    }
+    // output before any record named its test file goes where UnityOpenReport() would put it
+    if (UnityCacheLengthAt == 0)
+        UnityCacheSegment((Unity.TestFile != NULL) ? Unity.TestFile : "unity");
+    UnityCacheAppend(&UnityCaptures[0], text, length);
+}
+
+//-----------------------------------------------
+/// walk the report segments of the entry, playing them back if asked; 0 if they are malformed
+static int UnityCacheSegments(const char* report, const size_t size, const int replay)
+{
+    const char* end = &report[size];
+
+    while (report < end)
+    {
+        const char* name = report;
+        const char* data = (const char*)memchr(name, '\0', (size_t)(end - name));
+        unsigned long length = 0;
+        int i;
+
+        if ((data == NULL) || (end - ++data < UNITY_CACHE_DIGITS))
+            return 0;
+        for (i = 0; i < UNITY_CACHE_DIGITS; i++)
+        {
+            if ((*data < '0') || (*data > '9'))
+                return 0;
+            length = length * 10 + (unsigned long)(*data++ - '0');
+        }
+        if (length > (unsigned long)(end - data))
+            return 0;
+        if (replay)
+        {
+            UnitySwitchReport(name);
+            UnityPrintSpan(data, (_UU32)length, UNITY_CHANNEL_JSON);
+        }
+        report = &data[length];
+    }
+    return 1;
+}
+
+//-----------------------------------------------
+static void UnityCacheHash(unsigned long long* hash, const void* data, const size_t length)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+    unsigned long long h = *hash;
+    size_t i;
+
+    for (i = 0; i < length; i++)
+    {
+        h = (h ^ bytes[i]) * 1099511628211ULL;
+    }
+    *hash = h;
+}
+
+//-----------------------------------------------
+/// hash a string along with its terminator, so consecutive strings cannot run together
+static void UnityCacheHashString(unsigned long long* hash, const char* string)
+{
+    if (string == NULL)
+        string = "";
+    UnityCacheHash(hash, string, strlen(string) + 1);
+}
+
+//-----------------------------------------------
+/// hash the contents of a file; 0 if it cannot be read
+static int UnityCacheHashFile(unsigned long long* hash, const char* path)
+{
+    char buffer[65536];
+    size_t got;
+    FILE* file = fopen(path, "rb");
+
+    if (file == NULL)
+        return 0;
+    while ((got = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        UnityCacheHash(hash, buffer, got);
+    }
+    fclose(file);
+    return 1;
+}
+
+//-----------------------------------------------
+static void UnityCacheHashFilter(unsigned long long* hash, const struct _UnityFilter* filter)
+{
+    _UU32 i;
+
+    for (i = 0; i < UNITY_FILTER_SLOTS; i++)
+    {
+        if (filter->Names[i] != NULL)
+            UnityCacheHashString(hash, filter->Names[i]);
+    }
+    UnityCacheHashString(hash, "*");
+    for (i = 0; i < filter->GlobCount; i++)
+    {
+        UnityCacheHashString(hash, filter->Globs[i]);
+    }
+    UnityCacheHashString(hash, ";");
+}
+
+//-----------------------------------------------
+/// hash which of Unity's sinks this is; 0 for any other
+static int UnityCacheHashSink(unsigned long long* hash, const struct _UnitySink* sink)
+{
+    const char* name = NULL;
+
+    if (sink == &UnitySinkConsole)
+        name = "console";
+    else if (sink == &UnitySinkJson)
+        name = "json";
+    else if (sink == &UnitySinkJUnit)
+        name = "junit";
+    else if (sink == &UnitySinkNone)
+        name = "none";
+#ifdef UNITY_REPORT_BINARY
+    else if (sink == &UnitySinkBinary)
+        name = "binary";
+#endif
+    if (name == NULL)
+        return 0;
+    UnityCacheHashString(hash, name);
+    return 1;
+}
+
+//-----------------------------------------------
+/// the key of this run, or 0 if the executable cannot be read or it cannot be played back
+static int UnityCacheKeyOf(char* key)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    const char* inputs = Unity.CacheInputs;
+    const char* end;
+    char path[1024];
+    size_t length;
+    _UU32 i;
+
+    UnityCacheHashString(&hash, UNITY_CACHE_HEADER);
+    if (!UnityCacheHashFile(&hash, "/proc/self/exe"))
+        return 0;
+    UnityCacheHashString(&hash, Unity.TestFile);
+    UnityCacheHash(&hash, &UnityShardIndex, sizeof(UnityShardIndex));
+    UnityCacheHash(&hash, &UnityShardCount, sizeof(UnityShardCount));
+    UnityCacheHashFilter(&hash, &UnityInclude);
+    UnityCacheHashFilter(&hash, &UnityExclude);
+    UnityCacheHash(&hash, &UnityFullDiff, sizeof(UnityFullDiff));
+#ifdef UNITY_SUPPORT_TIMEOUTS
+    // a shorter limit turns slow passes into timeouts
+    UnityCacheHash(&hash, &UnityTestTimeout, sizeof(UnityTestTimeout));
+#endif
+    // sinks added before UnityBegin(); one of the program's own would get nothing on replay
+    for (i = 0; i < UnitySinkCount; i++)
+    {
+        if (!UnityCacheHashSink(&hash, UnitySinks[i]))
+            return 0;
+    }
+
+    // each input by name and contents; one that is missing counts too
+    if (inputs == NULL)
+        inputs = getenv("UNITY_CACHE_INPUTS");
+    for (; (inputs != NULL) && (*inputs != '\0'); inputs = (*end != '\0') ? end + 1 : end)
+    {
+        end = strchr(inputs, ',');
+        if (end == NULL)
+            end = inputs + strlen(inputs);
+        length = (size_t)(end - inputs);
+        if ((length == 0) || (length >= sizeof(path)))
+            continue;
+        memcpy(path, inputs, length);
+        path[length] = '\0';
+        UnityCacheHashString(&hash, path);
+        if (!UnityCacheHashFile(&hash, path))
+            UnityCacheHashString(&hash, "missing");
+    }
+#ifdef UNITY_SUPPORT_TIMING
+    // the baseline decides which benchmarks fail
+    inputs = (Unity.BaselineFile != NULL) ? Unity.BaselineFile : getenv("UNITY_BASELINE");
+    if ((inputs != NULL) && (inputs[0] != '\0'))
+        UnityCacheHashFile(&hash, inputs);
+#endif
+
+    for (i = 0; i < 16; i++)
+    {
+        key[i] = "0123456789abcdef"[(hash >> (60 - 4 * i)) & 0xF];
+    }
+    key[16] = '\0';
+    return 1;
+}
+
+//-----------------------------------------------
+/// <dir>/<key[0..1]>/<key>, or <dir>/<key[0..1]> without the key; 0 if it does not fit
+static int UnityCachePath(char* path, const size_t size, const int withKey)
+{
+    const int length = withKey ? snprintf(path, size, "%s/%.2s/%s", UnityCacheDir, UnityCacheKey, UnityCacheKey)
+                               : snprintf(path, size, "%s/%.2s", UnityCacheDir, UnityCacheKey);
+
+    return (length > 0) && ((size_t)length < size);
+}
+
+//-----------------------------------------------
+/// load the entry for this run, if there is a good one; it is then the most recently used
+static int UnityCacheLoad(void)
+{
+    char path[1024];
+    unsigned long console, report;
+    size_t size;
+    int result, header = 0;
+
+    if (!UnityCachePath(path, sizeof(path), 1))
+        return 0;
+    UnityCacheEntry = UnityReadFile(path, &size);
+    if (UnityCacheEntry == NULL)
+        return 0;
+    if ((sscanf(UnityCacheEntry, UNITY_CACHE_HEADER " %d %lu %lu\n%n", &result, &console, &report, &header) != 3) ||
+        (header == 0) || ((size_t)header + console + report != size) ||
+        !UnityCacheSegments(&UnityCacheEntry[(size_t)header + console], report, 0))
+    {
+        free(UnityCacheEntry);
+        UnityCacheEntry = NULL;
+        return 0;
+    }
+
+    UnityCacheResult = result;
+    UnityCacheConsole = console;
+    UnityCacheReport = report;
+    memmove(UnityCacheEntry, &UnityCacheEntry[header], console + report);
+    utimensat(AT_FDCWD, path, NULL, 0);
+    return 1;
+}
+
+// What an entry is weighed by when the cache is trimmed
+struct _UnityCacheFile
+{
+    char Path[1024];
+    off_t Size;
+    time_t Used;
+};
+
+//-----------------------------------------------
+static int UnityCompareCacheFiles(const void* left, const void* right)
+{
+    const struct _UnityCacheFile* a = (const struct _UnityCacheFile*)left;
+    const struct _UnityCacheFile* b = (const struct _UnityCacheFile*)right;
+
+    if (a->Used != b->Used)
+        return (a->Used < b->Used) ? -1 : 1;
+    return strcmp(a->Path, b->Path);
+}
+
+//-----------------------------------------------
+/// remove the least recently used entries until the cache fits in UNITY_CACHE_SIZE bytes
+static void UnityCacheTrim(void)
+{
+    struct _UnityCacheFile* files = NULL;
+    size_t count = 0, capacity = 0, i;
+    unsigned long long total = 0;
+    struct dirent* bucket;
+    struct dirent* entry;
+    struct stat status;
+    DIR* top = opendir(UnityCacheDir);
+    DIR* inner;
+    char path[1024];
+
+    if (top == NULL)
+        return;
+    while ((bucket = readdir(top)) != NULL)
+    {
+        // entries only live two hex digits down
+        if ((strlen(bucket->d_name) != 2) || (bucket->d_name[0] == '.'))
+            continue;
+        if ((snprintf(path, sizeof(path), "%s/%s", UnityCacheDir, bucket->d_name) >= (int)sizeof(path)) || ((inner = opendir(path)) == NULL))
+            continue;
+        while ((entry = readdir(inner)) != NULL)
+        {
+            if (entry->d_name[0] == '.')
+                continue;
+            if (count == capacity)
+            {
+                struct _UnityCacheFile* grown;
+                capacity = (capacity == 0) ? 64 : capacity * 2;
+                grown = (struct _UnityCacheFile*)realloc(files, capacity * sizeof(*files));
+                if (grown == NULL)
+                    break;
+                files = grown;
+            }
+            if ((snprintf(files[count].Path, sizeof(files[count].Path), "%s/%s/%s", UnityCacheDir, bucket->d_name, entry->d_name) >= (int)sizeof(files[count].Path)) ||
+                (stat(files[count].Path, &status) != 0) || !S_ISREG(status.st_mode))
+                continue;
+            files[count].Size = status.st_size;
+            files[count].Used = status.st_mtime;
+            total += (unsigned long long)status.st_size;
+            count++;
+        }
+        closedir(inner);
+    }
+    closedir(top);
+
+    if (total > (unsigned long long)UNITY_CACHE_SIZE)
+    {
+        qsort(files, count, sizeof(*files), UnityCompareCacheFiles);
+        for (i = 0; (i < count) && (total > (unsigned long long)UNITY_CACHE_SIZE); i++)
+        {
+            // another run may have removed it already
+            if ((remove(files[i].Path) == 0) || (errno == ENOENT))
+                total -= (unsigned long long)files[i].Size;
+        }
+    }
+    free(files);
+}
+
+//-----------------------------------------------
+/// write the recording under this run's key
+static void UnityCacheStore(const int result)
+{
+    char path[1024];
+    char temporary[1024];
+    FILE* file;
+    int ok;
+
+    if (!UnityCacheRecording)
+        return;
+    UnityCacheEndSegment();
+    UnityCacheRecording = 0;
+    if (!UnityCachePath(path, sizeof(path), 0))
+        return;
+    mkdir(UnityCacheDir, 0777);
+    mkdir(path, 0777);
+    // written beside the cache and renamed in, so a reader never sees half an entry
+    if ((snprintf(temporary, sizeof(temporary), "%s/.%s.%ld", UnityCacheDir, UnityCacheKey, (long)getpid()) >= (int)sizeof(temporary)) ||
+        !UnityCachePath(path, sizeof(path), 1))
+        return;
+    file = fopen(temporary, "wb");
+    if (file == NULL)
+        return;
+    ok = (fprintf(file, UNITY_CACHE_HEADER " %d %lu %lu\n", result, (unsigned long)UnityCaptures[1].Used, (unsigned long)UnityCaptures[0].Used) > 0) &&
+         (fwrite(UnityCaptures[1].Data, 1, UnityCaptures[1].Used, file) == UnityCaptures[1].Used) &&
+         (fwrite(UnityCaptures[0].Data, 1, UnityCaptures[0].Used, file) == UnityCaptures[0].Used);
+    ok &= (fclose(file) == 0);
+    if (!ok || (rename(temporary, path) != 0))
+    {
+        remove(temporary);
+        return;
+    }
+    UnityCacheTrim();
+}
+
+//-----------------------------------------------
+/// at UnityBegin: find this run in Unity.CacheDir (or UNITY_CACHE), or start recording it
+static void UnityCacheBegin(void)
+{
+    const char* dir = Unity.CacheDir;
+
+    UnityCacheForget();
+    if (dir == NULL)
+        dir = getenv("UNITY_CACHE");
+    if ((dir == NULL) || (dir[0] == '\0') || !UnityCacheKeyOf(UnityCacheKey))
+        return;
+    UnityCacheDir = dir;
+    if (!UnityCacheLoad())
+        UnityCacheRecording = 1;
+}
+
+//-----------------------------------------------
+/// at UnityEnd: play a cached run back and return what UnityEnd returned then
+static int UnityCacheReplay(void)
+{
+    const int result = UnityCacheResult;
+
+    fwrite(UnityCacheEntry, 1, UnityCacheConsole, stdout);
+    fflush(stdout);
+    UnityCacheSegments(&UnityCacheEntry[UnityCacheConsole], UnityCacheReport, 1);
+    UnityCloseReport();
+    UnityCacheForget();
+    return result;
+}
+#endif
+
+#ifdef UNITY_SUPPORT_TIMEOUTS
+//-----------------------------------------------
+// Test Timeouts
+//-----------------------------------------------
+// A test (setUp, the test and tearDown) that runs longer than its timeout is
+// interrupted by UNITY_TIMEOUT_SIGNAL from a POSIX timer, whose handler jumps
+// out through Unity.AbortFrame like a failed assertion.  The test is then
+// failed as timed out, and tearDown gets a timeout of its own to clean up in.
+// On Linux every thread has a timer of its own that signals only that thread,
+// so worker threads time out their tests just as the main thread does, each
+// through its own Unity.AbortFrame.  Elsewhere the signal cannot be aimed at
+// one thread, and worker threads are never interrupted.
+
+_UU32 UnityTestTimeout = UNITY_TEST_TIMEOUT_MS;
+
+static UNITY_THREAD_LOCAL timer_t UnityWatchdogTimer;
+static UNITY_THREAD_LOCAL int UnityWatchdogReady = 0;
+static UNITY_THREAD_LOCAL _UU32 UnityWatchdogLimit = 0;      // the current test's timeout in ms
+static UNITY_THREAD_LOCAL volatile sig_atomic_t UnityWatchdogArmed = 0;
+static UNITY_THREAD_LOCAL volatile sig_atomic_t UnityWatchdogFired = 0;
+#ifndef UNITY_WATCHDOG_PER_THREAD
+static int UnityWatchdogOff = 0;                            // set while worker threads run tests
+#else
+#define UnityWatchdogOff (0)
+#endif
+
+//-----------------------------------------------
+static void UnityWatchdogHandler(int sig)
+{
+    (void)sig;
+    if (!UnityWatchdogArmed)
+        return;
+    UnityWatchdogArmed = 0;
+    UnityWatchdogFired = 1;
+    longjmp(Unity.AbortFrame, 1);
+}
+
+//-----------------------------------------------
+/// (re)start the countdown for the current test; 0 stops it
+static void UnityWatchdogArm(const _UU32 ms)
+{
+    struct itimerspec due;
+    struct sigaction action;
+    struct sigevent event;
+
+    if (UnityWatchdogOff)
+        return;
+    if (!UnityWatchdogReady)
+    {
+        if (ms == 0)
+            return;
+        // SA_NODEFER: the handler never returns, so it must not leave the signal blocked
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = UnityWatchdogHandler;
+        action.sa_flags = SA_NODEFER;
+        sigemptyset(&action.sa_mask);
+        memset(&event, 0, sizeof(event));
+#ifdef UNITY_WATCHDOG_PER_THREAD
+        event.sigev_notify = SIGEV_THREAD_ID;
+        event.sigev_notify_thread_id = (pid_t)syscall(SYS_gettid);
+#else
+        event.sigev_notify = SIGEV_SIGNAL;
+#endif
+        event.sigev_signo = UNITY_TIMEOUT_SIGNAL;
+        if ((sigaction(UNITY_TIMEOUT_SIGNAL, &action, NULL) != 0) ||
+            (timer_create(CLOCK_MONOTONIC, &event, &UnityWatchdogTimer) != 0))
+            return;
+        UnityWatchdogReady = 1;
+    }
+
+    UnityWatchdogArmed = 0;
+    memset(&due, 0, sizeof(due));
+    due.it_value.tv_sec = (time_t)(ms / 1000);
+    due.it_value.tv_nsec = (long)(ms % 1000) * 1000000L;
+    timer_settime(UnityWatchdogTimer, 0, &due, NULL);
+    UnityWatchdogArmed = (ms > 0);
+}
+
+//-----------------------------------------------
+static void UnityWatchdogDisarm(void)
+{
+    if (UnityWatchdogArmed)
+        UnityWatchdogArm(0);
+}
+
+#if defined(UNITY_SUPPORT_THREADS) && defined(UNITY_WATCHDOG_PER_THREAD)
+//-----------------------------------------------
+/// delete this thread's timer before the thread goes away
+static void UnityWatchdogRelease(void)
+{
+    if (!UnityWatchdogReady)
+        return;
+    UnityWatchdogDisarm();
+    timer_delete(UnityWatchdogTimer);
+    UnityWatchdogReady = 0;
+}
+#endif
+
+//-----------------------------------------------
+/// give the running test ms milliseconds from now, in place of UnityTestTimeout (0 for no limit)
+void UnitySetTestTimeout(const _UU32 ms)
+{
+    if (UnityWatchdogOff)
+        return;
+    UnityWatchdogLimit = ms;
+    UnityWatchdogArm(ms);
+}
+
+//-----------------------------------------------
+/// fail the test that was interrupted, whatever it had come to before
+static void UnityWatchdogConclude(void)
+{
+    char detail[UNITY_FIELD_TEXT_SIZE];
+    _UU32 length;
+
+    if (!UnityWatchdogFired)
+        return;
+    UnityWatchdogFired = 0;
+
+    strcpy(detail, " Timed Out After ");
+    length = (_UU32)strlen(detail);
+    length += UnityFormatNumberUnsigned(&detail[length], UnityWatchdogLimit);
+    strcpy(&detail[length], " ms");
+
+    UnityTestResultsFailBegin(Unity.CurrentTestLineNumber);
+    UnityAddDetail(detail);
+    Unity.CurrentTestIgnored = 0;
+    Unity.CurrentTestFailed = 1;
+    Unity.CurrentTestTimedOut = 1;
+}
+
+//-----------------------------------------------
+/// UNITY_TEST_TIMEOUT_MS in the environment replaces the built in timeout
+static void UnityReadTimeout(void)
+{
+    const char* timeout = getenv("UNITY_TEST_TIMEOUT_MS");
+
+    if ((timeout != NULL) && (timeout[0] != '\0'))
+        UnityTestTimeout = (_UU32)strtoul(timeout, NULL, 10);
+}
+#endif
+
+//-----------------------------------------------
+// Control Functions
+//-----------------------------------------------
+
+void UnityFail(const char* msg, const UNITY_LINE_TYPE line)
+{
+    UNITY_SKIP_EXECUTION;
+
+    UnityTestResultsFailBegin(line);
+    if (msg != NULL)
+    {
+        UnityAddDetail(msg);
+    }
+    UNITY_FAIL_AND_BAIL;
+}
+
+//-----------------------------------------------
+void UnityIgnore(const char* msg, const UNITY_LINE_TYPE line)
+{
+    UNITY_SKIP_EXECUTION;
+
+    UnityTestResultsFailBegin(line);
+    if (msg != NULL)
+    {
+        UnityAddDetail(msg);
+    }
+    UNITY_IGNORE_AND_BAIL;
+}
+
+//-----------------------------------------------
+void setUp(void);
+void tearDown(void);
+void UnityDefaultTestRun(UnityTestFunction Func, const char* FuncName, const int FuncLineNum)
+{
+    if (!UnityTestSelected(FuncName))
+        return;
+    Unity.CurrentTestName = FuncName;
+    Unity.CurrentTestLineNumber = FuncLineNum;
+    Unity.NumberOfTests++;
+    UNITY_TIMING_BEGIN();
+    if (TEST_PROTECT())
+    {
+        UNITY_WATCHDOG_BEGIN();
+        setUp();
+        UNITY_TIMING_SWITCH(UNITY_PHASE_TEST);
+        Func();
+    }
+    if (TEST_PROTECT() && !(Unity.CurrentTestIgnored))
+    {
+        UNITY_WATCHDOG_TEARDOWN();
+        UNITY_TIMING_SWITCH(UNITY_PHASE_TEARDOWN);
+        tearDown();
+    }
+    UNITY_WATCHDOG_END();
+    UNITY_TIMING_END();
+    UnityConcludeTest();
+}
+
+//-----------------------------------------------
+// Benchmarks
+//-----------------------------------------------
+// A benchmark calls its function in timed batches and reports the min, median,
+// p99 and standard deviation of the time per call.  Values the compiler would
+// otherwise optimize away are passed to UNITY_DO_NOT_OPTIMIZE().
+
+#ifdef UNITY_SUPPORT_TIMING
+const void* volatile UnityOptimizerSink = NULL;
+
+//-----------------------------------------------
+static _UT UnityBenchmarkBatch(UnityTestFunction Func, const _UU32 iterations)
+{
+    const _UT started = UNITY_CLOCK_NS();
+    _UU32 i;
+
+    for (i = 0; i < iterations; i++)
+    {
+        Func();
+    }
+    return UNITY_CLOCK_NS() - started;
+}
+
+//-----------------------------------------------
+static _UT UnityBenchmarkRoot(const double value)
+{
+    double root = value;
+    int i;
+
+    if (value <= 0.0)
+        return 0;
+    for (i = 0; i < 64; i++)
+    {
+        root = 0.5 * (root + (value / root));
+    }
+    return (_UT)(root + 0.5);
+}
+
+//-----------------------------------------------
+void UnityBenchmark(UnityTestFunction Func)
+{
+    struct _UnityBenchmark* benchmark = &Unity.CurrentBenchmark;
+    const _UT target = (_UT)UNITY_BENCHMARK_TARGET_NS / UNITY_BENCHMARK_SAMPLES;
+    _UT samples[UNITY_BENCHMARK_SAMPLES];
+    _UT elapsed, sample, sum = 0;
+    _UU32 iterations = 1;
+    _UU32 i, j;
+    double deviation, variance = 0.0;
+
+    // calibrate: grow the batch until one takes long enough to time
+    for (;;)
+    {
+        elapsed = UnityBenchmarkBatch(Func, iterations);
+        if ((elapsed >= target) || (iterations >= 0x40000000u))
+            break;
+        if ((elapsed > 0) && ((target / elapsed) < 64))
+            iterations = (_UU32)(((_UT)iterations * target) / elapsed) + 1;
+        else
+            iterations *= 64;
+        if (iterations > 0x40000000u)
+            iterations = 0x40000000u;
+    }
+
+    for (i = 0; i < UNITY_BENCHMARK_WARMUP; i++)
+    {
+        UnityBenchmarkBatch(Func, iterations);
+    }
+
+    // time the samples in picoseconds per iteration, keeping them sorted
+    for (i = 0; i < UNITY_BENCHMARK_SAMPLES; i++)
+    {
+        sample = (UnityBenchmarkBatch(Func, iterations) * 1000) / iterations;
+        sum += sample;
+        for (j = i; (j > 0) && (samples[j - 1] > sample); j--)
+        {
+            samples[j] = samples[j - 1];
+        }
+        samples[j] = sample;
+    }
+
+    for (i = 0; i < UNITY_BENCHMARK_SAMPLES; i++)
+    {
+        deviation = (double)samples[i] - ((double)sum / UNITY_BENCHMARK_SAMPLES);
+        variance += deviation * deviation;
+    }
+    if (UNITY_BENCHMARK_SAMPLES > 1)
+        variance /= (UNITY_BENCHMARK_SAMPLES - 1);
+
+    benchmark->Iterations = iterations;
+    benchmark->Samples = UNITY_BENCHMARK_SAMPLES;
+    benchmark->Min = samples[0];
+    benchmark->Median = samples[UNITY_BENCHMARK_SAMPLES / 2];
+    benchmark->P99 = samples[((UNITY_BENCHMARK_SAMPLES * 99) + 99) / 100 - 1];
+    benchmark->Stddev = UnityBenchmarkRoot(variance);
+}
+
+//-----------------------------------------------
+static void UnityBenchmarkBody(void)
+{
+    UnityBenchmark(Unity.BenchmarkFunction);
+}
+
+//-----------------------------------------------
+void UnityDefaultBenchmarkRun(UnityTestFunction Func, const char* FuncName, const int FuncLineNum)
+{
+    Unity.BenchmarkFunction = Func;
+    UnityDefaultTestRun(UnityBenchmarkBody, FuncName, FuncLineNum);
+}
+
+//-----------------------------------------------
+// Benchmark Baseline
+//-----------------------------------------------
+// Unity.BaselineFile (or UNITY_BASELINE) names the JSON report of an earlier
+// run, which must not be the report this run writes.  Every benchmark whose
+// median is slower than it was there by UNITY_BASELINE_TOLERANCE and
+// UNITY_BASELINE_NOISE counts as a failure.
+
+// The keys of one record of a baseline report that matter here
+struct _UnityBaselineRecord
+{
+    char File[128];
+    char Name[128];
+    char Median[32];
+    char Stddev[32];
+};
+
+//-----------------------------------------------
+/// copy a quoted JSON string (truncating it) and return what follows it
+static const char* UnityScanString(const char* text, char* buffer, const _UU32 size)
+{
+    _UU32 length = 0;
+
+    for (text++; (*text != '\0') && (*text != '"'); text++)
     {
-        for (index=0; index<2; index++) {
-            UnityTestResultsFailBegin(lineNumber,index);
-            UnityPrint(UnityStrExpected[index],index);
-            UnityPrintNumberByStyle(expected, style,index);
-            UnityPrint(UnityStrWas,index);
-            UnityPrintNumberByStyle(actual, style,index);
-            UnityAddMsgIfSpecified(msg,index);
-        }
-        UNITY_OUTPUT_CHAR('\"',0);
-        UNITY_OUTPUT_CHAR('\n',0);
-        UNITY_OUTPUT_CHAR('}',0);
-        UNITY_FAIL_AND_BAIL;
+        if ((*text == '\\') && (text[1] != '\0'))
+            text++;
+        if (length + 1 < size)
+            buffer[length++] = *text;
     }
+    buffer[length] = '\0';
+    return (*text == '"') ? text + 1 : text;
 }
 
 //-----------------------------------------------
-void UnityAssertEqualIntArray(const _U_SINT* expected,
-                              const _U_SINT* actual,
-                              const _UU32 num_elements,
-                              const char* msg,
-                              const UNITY_LINE_TYPE lineNumber,
-                              const UNITY_DISPLAY_STYLE_T style)
+/// "12.345" to thousandths, ignoring any further decimals
+static _UT UnityParseThousandths(const char* text)
 {
-    _UU32 elements = num_elements;
-    const _US8* ptr_exp = (_US8*)expected;
-    const _US8* ptr_act = (_US8*)actual;
+    _UT whole = 0;
+    _UT fraction = 0;
+    _UU32 digits = 0;
 
-    UNITY_SKIP_EXECUTION;
-    _US32 index;
-    if (elements == 0)
+    for (; (*text >= '0') && (*text <= '9'); text++)
+    {
+        whole = (whole * 10) + (_UT)(*text - '0');
+    }
+    if (*text == '.')
     {
-        for (index=0; index<2; index++) {
-            UnityTestResultsFailBegin(lineNumber,index);
-            UnityPrint(UnityStrPointless,index);
-            UnityAddMsgIfSpecified(msg,index);
+        for (text++; (*text >= '0') && (*text <= '9'); text++)
+        {
+            if (digits < 3)
+            {
+                fraction = (fraction * 10) + (_UT)(*text - '0');
+                digits++;
+            }
         }
-        UNITY_FAIL_AND_BAIL;
     }
-    
-    if (UnityCheckArraysForNull((void*)expected, (void*)actual, lineNumber, msg) == 1)
+    for (; digits < 3; digits++)
+    {
+        fraction *= 10;
+    }
+    return (whole * 1000) + fraction;
+}
+
+//-----------------------------------------------
+static void UnityBaselineField(struct _UnityBaselineRecord* record, const char* key, const char* value)
+{
+    char* target = NULL;
+    _UU32 size = 0;
+
+    if (strcmp(key, "filename") == 0)
+    {
+        target = record->File;
+        size = sizeof(record->File);
+    }
+    else if ((strcmp(key, "functionn_name") == 0) || (strcmp(key, "name") == 0))
+    {
+        target = record->Name;
+        size = sizeof(record->Name);
+    }
+    else if (strcmp(key, "median_ns") == 0)
+    {
+        target = record->Median;
+        size = sizeof(record->Median);
+    }
+    else if (strcmp(key, "stddev_ns") == 0)
+    {
+        target = record->Stddev;
+        size = sizeof(record->Stddev);
+    }
+
+    if (target != NULL)
+    {
+        size_t length = strlen(value);
+        if (length >= size)
+            length = size - 1;
+        memcpy(target, value, length);
+        target[length] = '\0';
+    }
+}
+
+//-----------------------------------------------
+/// a later record for the same benchmark replaces an earlier one
+static void UnityBaselineApply(const struct _UnityBaselineRecord* record)
+{
+    const char* file;
+    _UU32 i;
+
+    if (record->Median[0] == '\0')
         return;
 
-    switch(style)
+    for (i = 0; i < UnityBaselineCount; i++)
     {
-        case UNITY_DISPLAY_STYLE_HEX8:
-        case UNITY_DISPLAY_STYLE_INT8:
-        case UNITY_DISPLAY_STYLE_UINT8:
-            while (elements--)
-            {
-                if (*ptr_exp != *ptr_act)
-                {
-                    for (index=0; index<2; index++) {
-                        UnityTestResultsFailBegin(lineNumber,index);
-                        UnityPrint(UnityStrElement,index);
-                        UnityPrintNumberByStyle((num_elements - elements - 1), UNITY_DISPLAY_STYLE_UINT,index);
-                        UnityPrint(UnityStrExpected[index],index);
-                        UnityPrintNumberByStyle(*ptr_exp, style,index);
-                        UnityPrint(UnityStrWas,index);
-                        UnityPrintNumberByStyle(*ptr_act, style,index);
-                        UnityAddMsgIfSpecified(msg,index);
-                    }
-                    UNITY_OUTPUT_CHAR('\"',0);
-                    UNITY_OUTPUT_CHAR('\n',0);
-                    UNITY_OUTPUT_CHAR('}',0);
-                    UNITY_FAIL_AND_BAIL;
-                    
-                }
-                ptr_exp += 1;
-                ptr_act += 1;
-            }
-            break;
-        case UNITY_DISPLAY_STYLE_HEX16:
-        case UNITY_DISPLAY_STYLE_INT16:
-        case UNITY_DISPLAY_STYLE_UINT16:
-            while (elements--)
+        file = (UnityBaselineEntries[i].File != NULL) ? UnityBaselineEntries[i].File : "";
+        if ((strcmp(UnityBaselineEntries[i].TestName, record->Name) == 0) && (strcmp(record->File, file) == 0))
+        {
+            UnityBaselineEntries[i].BaselineMedian = UnityParseThousandths(record->Median);
+            UnityBaselineEntries[i].BaselineStddev = UnityParseThousandths(record->Stddev);
+            UnityBaselineEntries[i].Found = 1;
+        }
+    }
+}
+
+//-----------------------------------------------
+/// scan a report for key/value pairs record by record, so it copes with either JSON layout
+static void UnityLoadBaseline(const char* text)
+{
+    struct _UnityBaselineRecord record;
+    char key[32];
+    char value[128];
+    _UU32 length;
+    int depth = 0;
+
+    memset(&record, 0, sizeof(record));
+    while (*text != '\0')
+    {
+        if (*text == '{')
+        {
+            if (depth++ == 0)
+                memset(&record, 0, sizeof(record));
+            text++;
+        }
+        else if (*text == '}')
+        {
+            if ((depth > 0) && (--depth == 0))
+                UnityBaselineApply(&record);
+            text++;
+        }
+        else if ((*text == '"') && (depth > 0))
+        {
+            text = UnityScanString(text, key, sizeof(key));
+            while ((*text == ' ') || (*text == '\t') || (*text == '\r') || (*text == '\n'))
+                text++;
+            if (*text != ':')
+                continue;
+            for (text++; (*text == ' ') || (*text == '\t'); text++)
+                ;
+            if (*text == '"')
             {
-                if (*(_US16*)ptr_exp != *(_US16*)ptr_act)
-                {
-                    for (index=0; index<2; index++) {
-                        UnityTestResultsFailBegin(lineNumber,index);
-                        UnityPrint(UnityStrElement,index);
-                        UnityPrintNumberByStyle((num_elements - elements - 1), UNITY_DISPLAY_STYLE_UINT,index);
-                        UnityPrint(UnityStrExpected[index],index);
-                        UnityPrintNumberByStyle(*(_US16*)ptr_exp, style,index);
-                        UnityPrint(UnityStrWas,index);
-                        UnityPrintNumberByStyle(*(_US16*)ptr_act, style,index);
-                        UnityAddMsgIfSpecified(msg,index);
-                    }
-                    UNITY_OUTPUT_CHAR('\"',0);
-                    UNITY_OUTPUT_CHAR('\n',0);
-                    UNITY_OUTPUT_CHAR('}',0);
-                    UNITY_FAIL_AND_BAIL;
-                }
-                ptr_exp += 2;
-                ptr_act += 2;
+                text = UnityScanString(text, value, sizeof(value));
             }
-            break;
-#ifdef UNITY_SUPPORT_64
-        case UNITY_DISPLAY_STYLE_HEX64:
-        case UNITY_DISPLAY_STYLE_INT64:
-        case UNITY_DISPLAY_STYLE_UINT64:
-            while (elements--)
+            else
             {
-                if (*(_US64*)ptr_exp != *(_US64*)ptr_act)
+                for (length = 0; (*text != '\0') && (strchr(",}] \t\r\n{[", *text) == NULL); text++)
                 {
-                    for ( index=0; index<2; index++) {
-                        UnityTestResultsFailBegin(lineNumber,index);
-                        UnityPrint(UnityStrElement,index);
-                        UnityPrintNumberByStyle((num_elements - elements - 1), UNITY_DISPLAY_STYLE_UINT,index);
-                        UnityPrint(UnityStrExpected[index],index);
-                        UnityPrintNumberByStyle(*(_US64*)ptr_exp, style,index);
-                        UnityPrint(UnityStrWas,index);
-                        UnityPrintNumberByStyle(*(_US64*)ptr_act, style,index);
-                        UnityAddMsgIfSpecified(msg,index);
-                    }
-                    UNITY_OUTPUT_CHAR('\"',0);
-                    UNITY_OUTPUT_CHAR('\n',0);
-                    UNITY_OUTPUT_CHAR('}',0);
-                    UNITY_FAIL_AND_BAIL;
-                }
-                ptr_exp += 8;
-                ptr_act += 8;
-            }
-            break;
-#endif
-        default:
-            while (elements--)
-            {
-                if (*(_US32*)ptr_exp != *(_US32*)ptr_act)
-                {        
-                    for (index=0; index<2; index++) {
-                        UnityTestResultsFailBegin(lineNumber,index);
-                        UnityPrint(UnityStrElement,index);
-                        UnityPrintNumberByStyle((num_elements - elements - 1), UNITY_DISPLAY_STYLE_UINT,index);
-                        UnityPrint(UnityStrExpected[index],index);
-                        UnityPrintNumberByStyle(*(_US32*)ptr_exp, style,index);
-                        UnityPrint(UnityStrWas,index);
-                        UnityPrintNumberByStyle(*(_US32*)ptr_act, style,index);
-                        UnityAddMsgIfSpecified(msg,index);
-                    }
-                    UNITY_OUTPUT_CHAR('\"',0);
-                    UNITY_OUTPUT_CHAR('\n',0);
-                    UNITY_OUTPUT_CHAR('}',0);
-                    UNITY_FAIL_AND_BAIL;
+                    if (length + 1 < sizeof(value))
+                        value[length++] = *text;
                 }
-                ptr_exp += 4;
-                ptr_act += 4;
+                value[length] = '\0';
             }
-            break;
+            UnityBaselineField(&record, key, value);
+        }
+        else
+        {
+            text++;
+        }
     }
 }
 
 //-----------------------------------------------
-#ifndef UNITY_EXCLUDE_FLOAT
-void UnityAssertEqualFloatArray(const _UF* expected,
-                                const _UF* actual,
-                                const _UU32 num_elements,
-                                const char* msg,
-                                const UNITY_LINE_TYPE lineNumber)
+/// signed change from the baseline, in tenths of a percent
+static void UnityPrintChange(const struct _UnityBaselineEntry* entry, _US32 index)
 {
-    _UU32 elements = num_elements;
-    const _UF* ptr_expected = expected;
-    const _UF* ptr_actual = actual;
-    _UF diff, tol;
-    _US32 index;
-    UNITY_SKIP_EXECUTION;
-  
-    if (elements == 0)
+    char digits[4];
+    _UT tenths;
+
+    if (entry->Median >= entry->BaselineMedian)
     {
-        for (index=0; index<2; index++) {
-            UnityTestResultsFailBegin(lineNumber,index);
-            UnityPrint(UnityStrPointless,index);
-            UnityAddMsgIfSpecified(msg,index);
-        }
-        UNITY_FAIL_AND_BAIL;
+        UNITY_OUTPUT_CHAR('+', index);
+        tenths = ((entry->Median - entry->BaselineMedian) * 1000) / entry->BaselineMedian;
     }
-    
-    if (UnityCheckArraysForNull((void*)expected, (void*)actual, lineNumber, msg) == 1)
+    else
+    {
+        UNITY_OUTPUT_CHAR('-', index);
+        tenths = ((entry->BaselineMedian - entry->Median) * 1000) / entry->BaselineMedian;
+    }
+    UnityPrintTime(tenths / 10, index);
+    digits[0] = '.';
+    digits[1] = (char)('0' + (tenths % 10));
+    digits[2] = '\0';
+    UnityPrint(digits, index);
+}
+
+//-----------------------------------------------
+static void UnityReportBaseline(const struct _UnityBaselineEntry* entry, const int regressed)
+{
+    _US32 index = UNITY_CHANNEL_CONSOLE;
+
+    UnityPrint(entry->File, index);
+    UNITY_OUTPUT_CHAR(':', index);
+    UnityPrintNumber(entry->LineNumber, index);
+    UNITY_OUTPUT_CHAR(':', index);
+    UnityPrint(entry->TestName, index);
+    UnityPrint(regressed ? ":FAIL: Regressed To " : ":PASS: Improved To ", index);
+    UnityPrintThousandths(entry->Median, index);
+    UnityPrint(" ns/iter From ", index);
+    UnityPrintThousandths(entry->BaselineMedian, index);
+    UnityPrint(" (", index);
+    UnityPrintChange(entry, index);
+    UnityPrint("%)", index);
+    UNITY_PRINT_EOL;
+
+#ifndef UNITY_REPORT_BINARY
+    index = UNITY_CHANNEL_JSON;
+    UnityJsonBeginRecord(entry->File, entry->TestName, entry->LineNumber);
+    UnityJsonLine(regressed ? "\"baseline\":\"REGRESSED\"," : "\"baseline\":\"IMPROVED\",");
+    UnityPrint("\"current_ns\":\"", index);
+    UnityPrintThousandths(entry->Median, index);
+    UnityJsonLine("\",");
+    UnityPrint("\"baseline_ns\":\"", index);
+    UnityPrintThousandths(entry->BaselineMedian, index);
+    UnityJsonLine("\",");
+    UnityPrint("\"change_pct\":\"", index);
+    UnityPrintChange(entry, index);
+    UnityJsonLine("\"");
+    UnityJsonEndRecord();
+#endif
+}
+
+//-----------------------------------------------
+/// compare this run's benchmark medians with the baseline report, counting regressions as failures
+static void UnityCompareBaseline(void)
+{
+    const char* path = Unity.BaselineFile;
+    const struct _UnityBaselineEntry* entry;
+    char* text;
+    _UT noise;
+    _UU32 i;
+
+    if (path == NULL)
+        path = getenv("UNITY_BASELINE");
+    if ((path == NULL) || (path[0] == '\0') || (UnityBaselineCount == 0))
+        return;
+
+    text = UnityReadFile(path, NULL);
+    if (text == NULL)
+    {
+        UnityPrint("Baseline Could Not Be Read: ", UNITY_CHANNEL_CONSOLE);
+        UnityPrint(path, UNITY_CHANNEL_CONSOLE);
+        UNITY_PRINT_EOL;
         return;
+    }
+    UnityLoadBaseline(text);
+    free(text);
 
-    while (elements--)
+    for (i = 0; i < UnityBaselineCount; i++)
     {
-        diff = *ptr_expected - *ptr_actual;
-        if (diff < 0.0)
-          diff = 0.0 - diff;
-        tol = UNITY_FLOAT_PRECISION * *ptr_expected;
-        if (tol < 0.0)
-            tol = 0.0 - tol;
-        if (diff > tol)
+        entry = &UnityBaselineEntries[i];
+        if (!entry->Found || (entry->BaselineMedian == 0))
+            continue;
+
+        noise = (entry->Stddev > entry->BaselineStddev) ? entry->Stddev : entry->BaselineStddev;
+        noise *= UNITY_BASELINE_NOISE;
+        if (((entry->Median * 100) > (entry->BaselineMedian * (100 + UNITY_BASELINE_TOLERANCE))) &&
+            ((entry->Median - entry->BaselineMedian) > noise))
         {
-            for (index=0; index<2; index++) {
-                UnityTestResultsFailBegin(lineNumber,index);
-                UnityPrint(UnityStrElement,index);
-                UnityPrintNumberByStyle((num_elements - elements - 1), UNITY_DISPLAY_STYLE_UINT,index);
-#ifdef UNITY_FLOAT_VERBOSE
-                UnityPrint(UnityStrExpected[index],index);
-                UnityPrintFloat(*ptr_expected,index);
-                UnityPrint(UnityStrWas,index);
-                UnityPrintFloat(*ptr_actual,index);
-#else
-                UnityPrint(UnityStrDelta,index);
+            UnityReportBaseline(entry, 1);
+            Unity.TestFailures++;
+        }
+        else if (((entry->Median * 100) < (entry->BaselineMedian * (100 - UNITY_BASELINE_TOLERANCE))) &&
+                 ((entry->BaselineMedian - entry->Median) > noise))
+        {
+            UnityReportBaseline(entry, 0);
+        }
+    }
+}
 #endif
-                UnityAddMsgIfSpecified(msg,index);
-            }
-            UNITY_OUTPUT_CHAR('\"',0);
-            UNITY_OUTPUT_CHAR('\n',0);
-            UNITY_OUTPUT_CHAR('}',0);
-            UNITY_FAIL_AND_BAIL;
+
+//-----------------------------------------------
+// Test Table Workers
+//-----------------------------------------------
+
+#if defined(UNITY_SUPPORT_THREADS) || defined(UNITY_SUPPORT_FORK)
+// A worker's Unity context commits into this one-record arena, which is
+// never reported from the worker; each result is detached after its test.
+struct _UnityWorkerArena
+{
+    struct _UnityArena Arena;
+    struct _UnityResult Result;
+    struct _UnityField Fields[UNITY_RESULT_MAX_FIELDS];
+    char Strings[UNITY_RESULT_ARENA_STRINGS];
+};
+
+//-----------------------------------------------
+/// deep copy a result into a single heap block, free() releases it
+static struct _UnityResult* UnityCloneResult(const struct _UnityResult* result, size_t* blockSize)
+{
+    size_t size = sizeof(struct _UnityResult) + result->FieldCount * sizeof(struct _UnityField);
+    struct _UnityResult* copy;
+    struct _UnityField* fields;
+    char* strings;
+    size_t length;
+    _UU32 i;
+
+    for (i = 0; i < result->FieldCount; i++)
+    {
+        if (result->Fields[i].String != NULL)
+            size += strlen(result->Fields[i].String) + 1;
+    }
+
+    copy = (struct _UnityResult*)malloc(size);
+    if (copy == NULL)
+        return NULL;
+    fields = (struct _UnityField*)(copy + 1);
+    strings = (char*)(fields + result->FieldCount);
+
+    *copy = *result;
+    copy->Fields = fields;
+    for (i = 0; i < result->FieldCount; i++)
+    {
+        fields[i] = result->Fields[i];
+        if (fields[i].String != NULL)
+        {
+            length = strlen(fields[i].String) + 1;
+            memcpy(strings, fields[i].String, length);
+            fields[i].String = strings;
+            strings += length;
+        }
+    }
+    if (blockSize != NULL)
+        *blockSize = size;
+    return copy;
+}
+
+//-----------------------------------------------
+static void UnityWorkerBegin(struct _UnityWorkerArena* worker, const char* testFile)
+{
+    memset(worker, 0, sizeof(*worker));
+    worker->Arena.Results = &worker->Result;
+    worker->Arena.Fields = worker->Fields;
+    worker->Arena.Strings = worker->Strings;
+    worker->Arena.ResultCapacity = 1;
+    worker->Arena.FieldCapacity = UNITY_RESULT_MAX_FIELDS;
+    worker->Arena.StringCapacity = sizeof(worker->Strings);
+
+    memset(&Unity.CurrentResult, 0, sizeof(Unity.CurrentResult));
+    Unity.TestFile = testFile;
+    Unity.Arena = &worker->Arena;
+    Unity.CurrentResult.Fields = Unity.CurrentFields;
+    Unity.NumberOfTests = 0;
+    Unity.TestFailures = 0;
+    Unity.TestIgnores = 0;
+    Unity.CurrentTestFailed = 0;
+    Unity.CurrentTestIgnored = 0;
+    Unity.CurrentTestTimedOut = 0;
+}
+
+//-----------------------------------------------
+/// run one test and hand back its result as a heap block (or NULL)
+static struct _UnityResult* UnityWorkerRun(struct _UnityWorkerArena* worker, const UnityTestEntry* test, size_t* blockSize)
+{
+    struct _UnityResult* result = NULL;
+
+    UnityDefaultTestRun(test->Func, test->FuncName, test->FuncLineNum);
+    if (worker->Arena.ResultCount > 0)
+    {
+        result = UnityCloneResult(&worker->Result, blockSize);
+    }
+    worker->Arena.ResultCount = 0;
+    worker->Arena.FieldCount = 0;
+    worker->Arena.StringCount = 0;
+    return result;
+}
+
+//-----------------------------------------------
+/// fold per-test results into this context's totals and report them in table order
+static void UnityMergeResults(struct _UnityResult** results, const _UU32 count)
+{
+    _UU32 i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (results[i] == NULL)
+            continue;
+        Unity.NumberOfTests++;
+        if ((results[i]->Status == UNITY_RESULT_FAIL) || (results[i]->Status == UNITY_RESULT_TIMEOUT))
+            Unity.TestFailures++;
+        else if (results[i]->Status == UNITY_RESULT_IGNORE)
+            Unity.TestIgnores++;
+        UnityCommitResult(results[i]);
+        free(results[i]);
+        results[i] = NULL;
+    }
+}
+#endif
+
+//-----------------------------------------------
+// Parallel Test Runner
+//-----------------------------------------------
+// Each worker thread has its own Unity context, so setUp, tearDown and the
+// tests themselves must be thread safe.  Results are reported in table order
+// once every test has finished.
+
+#ifdef UNITY_SUPPORT_THREADS
+struct _UnityParallelRun
+{
+    const UnityTestEntry* Tests;
+    const _UU32* Order;
+    _UU32 Count;
+    _UU32 Next;
+    struct _UnityResult** Results;
+    const char* TestFile;
+    pthread_mutex_t Lock;
+};
+
+//-----------------------------------------------
+static void* UnityParallelWorker(void* arg)
+{
+    struct _UnityParallelRun* run = (struct _UnityParallelRun*)arg;
+    struct _UnityWorkerArena worker;
+    _UU32 index;
+
+    // this thread's Unity starts out zeroed
+    UnityWorkerBegin(&worker, run->TestFile);
+
+    for (;;)
+    {
+        pthread_mutex_lock(&run->Lock);
+        index = run->Next++;
+        pthread_mutex_unlock(&run->Lock);
+        if (index >= run->Count)
+            break;
+        if (run->Order != NULL)
+            index = run->Order[index];
+
+        run->Results[index] = UnityWorkerRun(&worker, &run->Tests[index], NULL);
+    }
+#if defined(UNITY_SUPPORT_TIMEOUTS) && defined(UNITY_WATCHDOG_PER_THREAD)
+    UnityWatchdogRelease();
+#endif
+    return NULL;
+}
+
+//-----------------------------------------------
+void UnityParallelTestRun(const UnityTestEntry* table, const _UU32 total, const _UU32 workers)
+{
+    const UnityTestEntry* tests = table;
+    const _UU32 count = UnitySelectTests(&tests, total);
+    struct _UnityParallelRun run;
+    pthread_t* threads;
+    _UU32 threadCount = workers;
+    _UU32 i;
+    long cores;
+
+    if (threadCount == 0)
+    {
+        cores = sysconf(_SC_NPROCESSORS_ONLN);
+        threadCount = (cores > 0) ? (_UU32)cores : 1;
+    }
+    if (threadCount > count)
+        threadCount = count;
+
+    memset(&run, 0, sizeof(run));
+    run.Tests = tests;
+    run.Order = UnityOrderTests(tests, count);
+    run.Count = count;
+    run.TestFile = Unity.TestFile;
+    run.Results = (struct _UnityResult**)calloc(count ? count : 1, sizeof(struct _UnityResult*));
+    threads = (pthread_t*)calloc(threadCount ? threadCount : 1, sizeof(pthread_t));
+    pthread_mutex_init(&run.Lock, NULL);
+#if defined(UNITY_SUPPORT_TIMEOUTS) && !defined(UNITY_WATCHDOG_PER_THREAD)
+    if (UnityTestTimeout > 0)
+    {
+        UnityPrint("Timeouts Are Not Enforced On Worker Threads Here", UNITY_CHANNEL_CONSOLE);
+        UNITY_PRINT_EOL;
+    }
+    UnityWatchdogOff = 1;
+#endif
+
+    for (i = 0; i < threadCount; i++)
+    {
+        if (pthread_create(&threads[i], NULL, UnityParallelWorker, &run) != 0)
+            break;
+    }
+    // if no thread could be started, run the table serially instead
+    if (i == 0)
+    {
+        for (i = 0; i < count; i++)
+        {
+            UnityDefaultTestRun(tests[i].Func, tests[i].FuncName, tests[i].FuncLineNum);
         }
-        ptr_expected++;
-        ptr_actual++;
+        i = 0;
+    }
+    while (i > 0)
+    {
+        pthread_join(threads[--i], NULL);
+    }
+#if defined(UNITY_SUPPORT_TIMEOUTS) && !defined(UNITY_WATCHDOG_PER_THREAD)
+    UnityWatchdogOff = 0;
+#endif
+
+    UnityMergeResults(run.Results, count);
+
+    pthread_mutex_destroy(&run.Lock);
+    free(threads);
+    free(run.Results);
+    free((void*)run.Order);
+    if (tests != table)
+        free((void*)tests);
+}
+#endif
+
+//-----------------------------------------------
+// Forked Test Runner
+//-----------------------------------------------
+// A test that crashes, exits or runs past UNITY_FORK_TIMEOUT_MS only takes its
+// worker process down with it: it is reported as failed and a new worker takes
+// its place.
+
+#ifdef UNITY_SUPPORT_FORK
+#define UNITY_FORK_IDLE (0xFFFFFFFFu)
+
+struct _UnityForkWorker
+{
+    pid_t Pid;
+    int Command;    // parent writes test indexes here
+    int Reply;      // the child answers with a _UnityForkReply and a result block
+    _UU32 Test;
+    long Started;
+};
+
+struct _UnityForkReply
+{
+    _UU32 Test;
+    _UU32 Size;
+    _UP Base;
+};
+
+//-----------------------------------------------
+static long UnityForkMilliseconds(void)
+{
+    return (long)(UnityClockNs(CLOCK_MONOTONIC) / 1000000ULL);
+}
+
+//-----------------------------------------------
+static size_t UnityForkTransfer(const int fd, void* buffer, const size_t size, const int writing)
+{
+    size_t done = 0;
+    ssize_t n;
+
+    while (done < size)
+    {
+        if (writing)
+            n = write(fd, (const char*)buffer + done, size - done);
+        else
+            n = read(fd, (char*)buffer + done, size - done);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            break;
+        done += (size_t)n;
     }
+    return done;
 }
 
 //-----------------------------------------------
-void UnityAssertFloatsWithin(const _UF delta,
-                             const _UF expected,
-                             const _UF actual,
-                             const char* msg,
-                             const UNITY_LINE_TYPE lineNumber)
+static void UnityForkChild(const UnityTestEntry* tests, const int command, const int reply)
 {
-    _UF diff = actual - expected;
-    _UF pos_delta = delta;
-    _US32 index;
-    UNITY_SKIP_EXECUTION;
-  
-    if (diff < 0)
-    {
-        diff = 0.0f - diff;
-    }
-    if (pos_delta < 0)
-    {
-        pos_delta = 0.0f - pos_delta;
-    }
+    struct _UnityWorkerArena worker;
+    struct _UnityForkReply header;
+    struct _UnityResult* result;
+    size_t size;
+    _UU32 index;
 
-    if (pos_delta < diff)
-    {
-        for (index=0; index<2; index++) {
-            UnityTestResultsFailBegin(lineNumber,index);
-#ifdef UNITY_FLOAT_VERBOSE
-            UnityPrint(UnityStrExpected[index],index);
-            UnityPrintFloat(expected,index);
-            UnityPrint(UnityStrWas,index);
-            UnityPrintFloat(actual,index);
-#else
-            UnityPrint(UnityStrDelta,index);
+    // crashes go to the handlers from before UnityBegin(), so the parent sees the signal
+    UNITY_CRASH_FLUSH_REMOVE();
+    // the report and JUnit files are the parent's to write, even if a test calls exit()
+#ifndef UNITY_EXCLUDE_CRASH_FLUSH
+    UnityFlushAtExit = 0;
 #endif
-            UnityAddMsgIfSpecified(msg,index);
+    UnityDropReport();
+    UnityDropJUnit();
+#ifdef UNITY_SUPPORT_TIMEOUTS
+    // timers are not inherited, so the child makes its own
+    UnityWatchdogReady = 0;
+    UnityWatchdogArmed = 0;
+#endif
+    UnityWorkerBegin(&worker, Unity.TestFile);
+
+    while (UnityForkTransfer(command, &index, sizeof(index), 0) == sizeof(index))
+    {
+        size = 0;
+        result = UnityWorkerRun(&worker, &tests[index], &size);
+        fflush(stdout);
+
+        header.Test = index;
+        header.Size = (_UU32)size;
+        header.Base = (_UP)result;
+        if ((UnityForkTransfer(reply, &header, sizeof(header), 1) != sizeof(header)) ||
+            (UnityForkTransfer(reply, result, size, 1) != size))
+        {
+            break;
         }
-        UNITY_OUTPUT_CHAR('\"',0);
-        UNITY_OUTPUT_CHAR('\n',0);
-        UNITY_OUTPUT_CHAR('}',0);
-        UNITY_FAIL_AND_BAIL;
+        free(result);
     }
+    _exit(0);
 }
 
-#endif //not UNITY_EXCLUDE_FLOAT
-
 //-----------------------------------------------
-#ifndef UNITY_EXCLUDE_DOUBLE
-void UnityAssertEqualDoubleArray(const _UD* expected,
-                                 const _UD* actual,
-                                 const _UU32 num_elements,
-                                 const char* msg,
-                                 const UNITY_LINE_TYPE lineNumber)
+static int UnityForkSpawn(struct _UnityForkWorker* pool, const _UU32 poolSize, struct _UnityForkWorker* worker, const UnityTestEntry* tests)
 {
-    _UU32 elements = num_elements;
-    const _UD* ptr_expected = expected;
-    const _UD* ptr_actual = actual;
-    _UD diff, tol;
-    int index;
-    UNITY_SKIP_EXECUTION;
-  
-    if (elements == 0)
+    int command[2];
+    int reply[2];
+    pid_t pid;
+    _UU32 i;
+
+    if (pipe(command) != 0)
+        return 0;
+    if (pipe(reply) != 0)
     {
-        for (index=0; index<2; index++) {
-            UnityTestResultsFailBegin(lineNumber,index);
-            UnityPrint(UnityStrPointless,index);
-            UnityAddMsgIfSpecified(msg,index);
-        }
-        UNITY_FAIL_AND_BAIL;
+        close(command[0]);
+        close(command[1]);
+        return 0;
     }
-    
-    if (UnityCheckArraysForNull((void*)expected, (void*)actual, lineNumber, msg) == 1)
-        return;
 
-    while (elements--)
+    pid = fork();
+    if (pid < 0)
+    {
+        close(command[0]);
+        close(command[1]);
+        close(reply[0]);
+        close(reply[1]);
+        return 0;
+    }
+    if (pid == 0)
     {
-        diff = *ptr_expected - *ptr_actual;
-        if (diff < 0.0)
-          diff = 0.0 - diff;
-        tol = UNITY_DOUBLE_PRECISION * *ptr_expected;
-        if (tol < 0.0)
-            tol = 0.0 - tol;
-        if (diff > tol)
+        // drop the other workers' pipes so they still see EOF at shutdown
+        for (i = 0; i < poolSize; i++)
         {
-            for (index=0; index<2; index++) {
-                UnityTestResultsFailBegin(lineNumber,index);
-                UnityPrint(UnityStrElement,index);
-                UnityPrintNumberByStyle((num_elements - elements - 1), UNITY_DISPLAY_STYLE_UINT,index);
-#ifdef UNITY_DOUBLE_VERBOSE
-                UnityPrint(UnityStrExpected[index],index);
-                UnityPrintFloat((float)(*ptr_expected),index);
-                UnityPrint(UnityStrWas,index);
-                UnityPrintFloat((float)(*ptr_actual),index);
-#else
-                UnityPrint(UnityStrDelta,index);
-#endif
-                UnityAddMsgIfSpecified(msg,index);
+            if ((&pool[i] != worker) && (pool[i].Pid > 0))
+            {
+                close(pool[i].Command);
+                close(pool[i].Reply);
             }
-            UNITY_OUTPUT_CHAR('\"',0);
-            UNITY_OUTPUT_CHAR('\n',0);
-            UNITY_OUTPUT_CHAR('}',0);
-            UNITY_FAIL_AND_BAIL;
         }
-        ptr_expected++;
-        ptr_actual++;
+        close(command[1]);
+        close(reply[0]);
+        UnityForkChild(tests, command[0], reply[1]);
     }
+
+    close(command[0]);
+    close(reply[1]);
+    worker->Pid = pid;
+    worker->Command = command[1];
+    worker->Reply = reply[0];
+    worker->Test = UNITY_FORK_IDLE;
+    return 1;
 }
 
 //-----------------------------------------------
-void UnityAssertDoublesWithin(const _UD delta,
-                              const _UD expected,
-                              const _UD actual,
-                              const char* msg,
-                              const UNITY_LINE_TYPE lineNumber)
+static void UnityForkRetire(struct _UnityForkWorker* worker, int* status)
 {
-    _UD diff = actual - expected;
-    _UD pos_delta = delta;
-    _US32 index;
-    UNITY_SKIP_EXECUTION;
-  
-    if (diff < 0)
-    {
-        diff = 0.0f - diff;
-    }
-    if (pos_delta < 0)
-    {
-        pos_delta = 0.0f - pos_delta;
-    }
+    close(worker->Command);
+    close(worker->Reply);
+    while ((waitpid(worker->Pid, status, 0) < 0) && (errno == EINTR))
+        ;
+    worker->Pid = 0;
+    worker->Test = UNITY_FORK_IDLE;
+}
 
-    if (pos_delta < diff)
-    {
-        for (index=0; index<2; index++) {
-            UnityTestResultsFailBegin(lineNumber,index);
-#ifdef UNITY_DOUBLE_VERBOSE
-            UnityPrint(UnityStrExpected[index],index);
-            UnityPrintFloat((float)expected,index);
-            UnityPrint(UnityStrWas,index);
-            UnityPrintFloat((float)actual,index);
+//-----------------------------------------------
+/// a result for a test whose worker never answered
+static struct _UnityResult* UnityForkFailure(const UnityTestEntry* test, const long elapsed, const char* detail, const _UU32 number, const char* unit)
+{
+    struct _UnityResult result;
+    struct _UnityField field;
+    char text[UNITY_FIELD_TEXT_SIZE * 2];
+    _UU32 length;
+
+    length = (_UU32)strlen(detail);
+    memcpy(text, detail, length);
+    length += UnityFormatNumberUnsigned(&text[length], number);
+    strcpy(&text[length], unit);
+
+    memset(&field, 0, sizeof(field));
+    field.Kind = UNITY_FIELD_DETAIL;
+    field.Type = UNITY_VALUE_TEXT;
+    field.String = text;
+
+    memset(&result, 0, sizeof(result));
+    result.File = Unity.TestFile;
+    result.TestName = test->FuncName;
+    result.TestLineNumber = (UNITY_LINE_TYPE)test->FuncLineNum;
+    result.LineNumber = (UNITY_LINE_TYPE)test->FuncLineNum;
+    result.Status = UNITY_RESULT_FAIL;
+    result.FieldCount = 1;
+    result.Fields = &field;
+#ifdef UNITY_SUPPORT_TIMING
+    result.Timing.Phase[UNITY_PHASE_TEST] = (_UT)elapsed * 1000000;
 #else
-            UnityPrint(UnityStrDelta,index);
+    (void)elapsed;
 #endif
-            UnityAddMsgIfSpecified(msg,index);
-        }
-        UNITY_OUTPUT_CHAR('\"',0);
-        UNITY_OUTPUT_CHAR('\n',0);
-        UNITY_OUTPUT_CHAR('}',0);
-        UNITY_FAIL_AND_BAIL;
-    }
+    return UnityCloneResult(&result, NULL);
 }
 
-#endif // not UNITY_EXCLUDE_DOUBLE
-
 //-----------------------------------------------
-void UnityAssertNumbersWithin( const _U_SINT delta,
-                               const _U_SINT expected,
-                               const _U_SINT actual,
-                               const char* msg,
-                               const UNITY_LINE_TYPE lineNumber,
-                               const UNITY_DISPLAY_STYLE_T style)
+/// read a worker's answer; NULL if the worker died (*sent is then -1) or its *sent bytes do not hold a result
+static struct _UnityResult* UnityForkCollect(struct _UnityForkWorker* worker, long* sent)
 {
-    UNITY_SKIP_EXECUTION;
-    _US32 index;    
-    if ((style & UNITY_DISPLAY_RANGE_INT) == UNITY_DISPLAY_RANGE_INT)
+    struct _UnityForkReply header;
+    struct _UnityResult* result;
+    _UP offset;
+    _UU32 i;
+
+    *sent = -1;
+    if (UnityForkTransfer(worker->Reply, &header, sizeof(header), 0) != sizeof(header))
+        return NULL;
+    *sent = (long)header.Size;
+    // a worker that could not copy its result sends an empty block
+    if (header.Size < sizeof(struct _UnityResult))
+        return NULL;
+    result = (struct _UnityResult*)malloc(header.Size);
+    if (result == NULL)
+        return NULL;
+    if (UnityForkTransfer(worker->Reply, result, header.Size, 0) != header.Size)
     {
-        if (actual > expected)
-          Unity.CurrentTestFailed = ((actual - expected) > delta);
-        else
-          Unity.CurrentTestFailed = ((expected - actual) > delta);
+        *sent = -1;
+        free(result);
+        return NULL;
     }
-    else
+
+    // the block was built at header.Base in the child; point it at our copy, once
+    // everything it points at is known to lie inside it
+    offset = (_UP)result->Fields - header.Base;
+    if ((result->FieldCount > UNITY_RESULT_MAX_FIELDS) || (offset < sizeof(struct _UnityResult)) || (offset > header.Size) ||
+        (result->FieldCount * sizeof(struct _UnityField) > header.Size - offset))
     {
-        if ((_U_UINT)actual > (_U_UINT)expected)
-            Unity.CurrentTestFailed = ((_U_UINT)(actual - expected) > (_U_UINT)delta);
-        else
-            Unity.CurrentTestFailed = ((_U_UINT)(expected - actual) > (_U_UINT)delta);
+        free(result);
+        return NULL;
     }
-
-    if (Unity.CurrentTestFailed)
+    result->Fields = (const struct _UnityField*)((char*)result + offset);
+    for (i = 0; i < result->FieldCount; i++)
     {
-        for (index=0; index<2; index++) {
-            UnityTestResultsFailBegin(lineNumber,index);
-            UnityPrint(UnityStrDelta,index);
-            UnityPrintNumberByStyle(delta, style,index);
-            UnityPrint(UnityStrExpected[index],index);
-            UnityPrintNumberByStyle(expected, style,index);
-            UnityPrint(UnityStrWas,index);
-            UnityPrintNumberByStyle(actual, style,index);
-            UnityAddMsgIfSpecified(msg,index);
-        }
-        UNITY_OUTPUT_CHAR('\"',0);
-        UNITY_OUTPUT_CHAR('\n',0);
-        UNITY_OUTPUT_CHAR('}',0);
-        UNITY_FAIL_AND_BAIL;
+        struct _UnityField* field = (struct _UnityField*)&result->Fields[i];
+        if (field->String == NULL)
+            continue;
+        offset = (_UP)field->String - header.Base;
+        if ((offset >= header.Size) || (memchr((char*)result + offset, '\0', header.Size - offset) == NULL))
+        {
+            free(result);
+            return NULL;
+        }
+        field->String = (char*)result + offset;
     }
+    return result;
 }
 
 //-----------------------------------------------
-void UnityAssertEqualString(const char* expected,
-                            const char* actual,
-                            const char* msg,
-                            const UNITY_LINE_TYPE lineNumber)
+void UnityForkedTestRun(const UnityTestEntry* table, const _UU32 total, const _UU32 workers)
 {
-    _UU32 i;
-    _US32 index;
-    UNITY_SKIP_EXECUTION;
-  
-    // if both pointers not null compare the strings
-    if (expected && actual)
+    const UnityTestEntry* tests = table;
+    const _UU32 count = UnitySelectTests(&tests, total);
+    struct _UnityForkWorker* pool;
+    struct _UnityResult** results;
+    struct pollfd* polls;
+    _UU32* order;
+    void (*oldPipe)(int);
+    _UU32 poolSize = workers;
+    _UU32 next = 0;
+    _UU32 done = 0;
+    _UU32 busy, i, test;
+    long now, wait, sent;
+    int status;
+    long cores;
+
+    if (poolSize == 0)
     {
-        for (i = 0; expected[i] || actual[i]; i++)
-        {
-            if (expected[i] != actual[i])
-            {
-                Unity.CurrentTestFailed = 1;
-                break;
-            }
-        }
+        cores = sysconf(_SC_NPROCESSORS_ONLN);
+        poolSize = (cores > 0) ? (_UU32)cores : 1;
     }
-    else
-    { // handle case of one pointers being null (if both null, test should pass)
-        if (expected != actual)
-        {
-            Unity.CurrentTestFailed = 1;
-        }
+    if (poolSize > count)
+        poolSize = count;
+    if (poolSize == 0)
+    {
+        if (tests != table)
+            free((void*)tests);
+        return;
     }
 
-    if (Unity.CurrentTestFailed)
+    pool = (struct _UnityForkWorker*)calloc(poolSize, sizeof(struct _UnityForkWorker));
+    polls = (struct pollfd*)calloc(poolSize, sizeof(struct pollfd));
+    results = (struct _UnityResult**)calloc(count, sizeof(struct _UnityResult*));
+    order = UnityOrderTests(tests, count);
+
+    // children inherit our buffers, so empty them (the JUnit file's too) before the first fork
+    UnityFlushResults();
+    UnityFlushReport();
+    fflush(NULL);
+    oldPipe = signal(SIGPIPE, SIG_IGN);
+
+    for (i = 0; i < poolSize; i++)
     {
-        for (index=0; index<2; index++) {
-            UnityTestResultsFailBegin(lineNumber,index);
-            UnityPrintExpectedAndActualStrings(expected, actual);
-            UnityAddMsgIfSpecified(msg,index);
-        }
-        UNITY_OUTPUT_CHAR('\"',0);
-        UNITY_OUTPUT_CHAR('}',0);
-        UNITY_FAIL_AND_BAIL;
+        if (!UnityForkSpawn(pool, poolSize, &pool[i], tests))
+            break;
     }
-}
-
-//-----------------------------------------------
-void UnityAssertEqualStringArray( const char** expected,
-                                  const char** actual,
-                                  const _UU32 num_elements,
-                                  const char* msg,
-                                  const UNITY_LINE_TYPE lineNumber)
-{
-    _UU32 i, j = 0;
-    _US32 index;    
-    UNITY_SKIP_EXECUTION;
-  
-    // if no elements, it's an error
-    if (num_elements == 0)
+    if (i == 0)
     {
-        for (index=0; index<2; index++) {
-            UnityTestResultsFailBegin(lineNumber,index);
-            UnityPrint(UnityStrPointless,index);
-            UnityAddMsgIfSpecified(msg,index);
+        // no worker process could be started, so run the table here
+        for (i = 0; i < count; i++)
+        {
+            UnityDefaultTestRun(tests[i].Func, tests[i].FuncName, tests[i].FuncLineNum);
         }
-        UNITY_FAIL_AND_BAIL;
+        done = count;
     }
+    poolSize = i;
 
-    if (UnityCheckArraysForNull((void*)expected, (void*)actual, lineNumber, msg) == 1)
-        return;
-    
-    do
+    while (done < count)
     {
-        // if both pointers not null compare the strings
-        if (expected[j] && actual[j])
+        // hand out work to idle workers
+        for (i = 0; (i < poolSize) && (next < count); i++)
         {
-            for (i = 0; expected[j][i] || actual[j][i]; i++)
-            {
-                if (expected[j][i] != actual[j][i])
-                {
-                    Unity.CurrentTestFailed = 1;
-                    break;
-                }
-            }
-        }
-        else
-        { // handle case of one pointers being null (if both null, test should pass)
-            if (expected[j] != actual[j])
+            if ((pool[i].Pid == 0) && !UnityForkSpawn(pool, poolSize, &pool[i], tests))
+                continue;
+            if (pool[i].Test != UNITY_FORK_IDLE)
+                continue;
+            test = (order != NULL) ? order[next] : next;
+            if (UnityForkTransfer(pool[i].Command, &test, sizeof(test), 1) != sizeof(test))
             {
-                Unity.CurrentTestFailed = 1;
+                // died between tests; start a fresh one next time round
+                UnityForkRetire(&pool[i], &status);
+                continue;
             }
+            pool[i].Test = test;
+            next++;
+            pool[i].Started = UnityForkMilliseconds();
         }
 
-        if (Unity.CurrentTestFailed)
+        // wait for an answer or the nearest deadline
+        busy = 0;
+        wait = -1;
+        now = UnityForkMilliseconds();
+        for (i = 0; i < poolSize; i++)
         {
-            for (index=0; index<2; index++) {
-                UnityTestResultsFailBegin(lineNumber,index);
-                if (num_elements > 1)
-                {
-                    UnityPrint(UnityStrElement,index);
-                    UnityPrintNumberByStyle((num_elements - j - 1), UNITY_DISPLAY_STYLE_UINT,index);
-                }
-                UnityPrintExpectedAndActualStrings((const char*)(expected[j]), (const char*)(actual[j]));
-                UnityAddMsgIfSpecified(msg,index);
-            }
-            UNITY_FAIL_AND_BAIL;
-        } 
-    } while (++j < num_elements);
-}
-
-//-----------------------------------------------
-void UnityAssertEqualMemory( const void* expected,
-                             const void* actual,
-                             const _UU32 length,
-                             const _UU32 num_elements,
-                             const char* msg,
-                             const UNITY_LINE_TYPE lineNumber)
-{
-    unsigned char* ptr_exp = (unsigned char*)expected;
-    unsigned char* ptr_act = (unsigned char*)actual;
-    _UU32 elements = num_elements;
-    _UU32 bytes;
-    _US32 index;
-    UNITY_SKIP_EXECUTION;
-  
-    if ((elements == 0) || (length == 0))
-    {
-        for (index=0; index<2; index++) {
-            UnityTestResultsFailBegin(lineNumber,index);
-            UnityPrint(UnityStrPointless,index);
-            UnityAddMsgIfSpecified(msg,index);
+            polls[i].fd = -1;
+            polls[i].events = POLLIN;
+            polls[i].revents = 0;
+            if (pool[i].Test == UNITY_FORK_IDLE)
+                continue;
+            polls[i].fd = pool[i].Reply;
+            busy++;
+#if (UNITY_FORK_TIMEOUT_MS > 0)
+            if ((wait < 0) || (pool[i].Started + UNITY_FORK_TIMEOUT_MS - now < wait))
+                wait = pool[i].Started + UNITY_FORK_TIMEOUT_MS - now;
+            if (wait < 0)
+                wait = 0;
+#endif
         }
-        UNITY_FAIL_AND_BAIL;
-    }
-
-    if (UnityCheckArraysForNull((void*)expected, (void*)actual, lineNumber, msg) == 1)
-        return;
-        
-    while (elements--)
-    {
-        /////////////////////////////////////
-        bytes = length;
-        while (bytes--)
+        if (busy == 0)
         {
-            if (*ptr_exp != *ptr_act)
+            // every spawn failed; fail the remaining tests rather than spin
+            for (; next < count; next++, done++)
             {
-                for (index=0; index<2; index++) {
-                    UnityTestResultsFailBegin(lineNumber,index);
-                    UnityPrint(UnityStrMemory,index);
-                    if (num_elements > 1)
-                    {
-                        UnityPrint(UnityStrElement,index);
-                        UnityPrintNumberByStyle((num_elements - elements - 1), UNITY_DISPLAY_STYLE_UINT,index);
-                    }
-                    UnityPrint(UnityStrByte,index);
-                    UnityPrintNumberByStyle((length - bytes - 1), UNITY_DISPLAY_STYLE_UINT,index);
-                    UnityPrint(UnityStrExpected[index],index);
-                    UnityPrintNumberByStyle(*ptr_exp, UNITY_DISPLAY_STYLE_HEX8,index);
-                    UnityPrint(UnityStrWas,index);
-                    UnityPrintNumberByStyle(*ptr_act, UNITY_DISPLAY_STYLE_HEX8,index);
-                    UnityAddMsgIfSpecified(msg,index);
-                }
-                UNITY_OUTPUT_CHAR('\"',0);
-                UNITY_OUTPUT_CHAR('\n',0);
-                UNITY_OUTPUT_CHAR('}',0);
-                UNITY_FAIL_AND_BAIL;
+                test = (order != NULL) ? order[next] : next;
+                results[test] = UnityForkFailure(&tests[test], 0, " Could Not Start Worker", 0, "");
             }
-            ptr_exp += 1;
-            ptr_act += 1;
+            break;
         }
-        /////////////////////////////////////
-        
-    }
-}
-
-//-----------------------------------------------
-// Control Functions
-//-----------------------------------------------
+        if ((poll(polls, poolSize, (int)wait) < 0) && (errno != EINTR))
+            break;
 
-void UnityFail(const char* msg, const UNITY_LINE_TYPE line)
-{
-    UNITY_SKIP_EXECUTION;
-    _US32 index;
-    for (index=0; index<2; index++) {
-        UnityTestResultsBegin(Unity.TestFile, line, index);
-        UnityPrintFail();
-        if (msg != NULL)
+        now = UnityForkMilliseconds();
+        for (i = 0; i < poolSize; i++)
         {
-            UNITY_OUTPUT_CHAR(':',index);
-            if (msg[0] != ' ')
-            {
-                UNITY_OUTPUT_CHAR(' ',index);  
-            }
-            UnityPrint(msg,index);
-        }
-    }
-    UNITY_FAIL_AND_BAIL;
-}
+            test = pool[i].Test;
+            if (test == UNITY_FORK_IDLE)
+                continue;
 
-//-----------------------------------------------
-void UnityIgnore(const char* msg, const UNITY_LINE_TYPE line)
-{
-    UNITY_SKIP_EXECUTION;
-    _US32 index;
-    for (index=0; index<2; index++) {
-        UnityTestResultsBegin(Unity.TestFile, line, index);
-        if (index==1) {
-            UnityPrint("IGNORE",index);
-            if (msg != NULL)
+            if (polls[i].revents != 0)
             {
-                UNITY_OUTPUT_CHAR(':',index);
-                UNITY_OUTPUT_CHAR(' ',index);
-                UnityPrint(msg,index);
+                results[test] = UnityForkCollect(&pool[i], &sent);
+                if (results[test] == NULL)
+                {
+                    UnityForkRetire(&pool[i], &status);
+                    if (sent >= 0)
+                        results[test] = UnityForkFailure(&tests[test], now - pool[i].Started, " Sent A Broken Result Of ", (_UU32)sent, " Bytes");
+                    else if (WIFSIGNALED(status))
+                        results[test] = UnityForkFailure(&tests[test], now - pool[i].Started, " Crashed With Signal ", (_UU32)WTERMSIG(status), "");
+                    else
+                        results[test] = UnityForkFailure(&tests[test], now - pool[i].Started, " Exited With Status ", (_UU32)WEXITSTATUS(status), "");
+                }
+                pool[i].Test = UNITY_FORK_IDLE;
+                done++;
             }
-        }
-        else if(index==0){
-            UNITY_OUTPUT_CHAR('\"',index);
-            UnityPrint("IGNORE",index);
-            UNITY_OUTPUT_CHAR('\"',index);
-            UNITY_OUTPUT_CHAR(':',index);
-            UNITY_OUTPUT_CHAR(' ',index);
-            UNITY_OUTPUT_CHAR('\"',index);
-            if (msg != NULL)
+#if (UNITY_FORK_TIMEOUT_MS > 0)
+            else if (now - pool[i].Started >= UNITY_FORK_TIMEOUT_MS)
             {
-                UnityPrint(msg,index); 
+                kill(pool[i].Pid, SIGKILL);
+                UnityForkRetire(&pool[i], &status);
+                results[test] = UnityForkFailure(&tests[test], now - pool[i].Started, " Timed Out After ", UNITY_FORK_TIMEOUT_MS, " ms");
+                if (results[test] != NULL)
+                    results[test]->Status = UNITY_RESULT_TIMEOUT;
+                done++;
             }
-            UNITY_OUTPUT_CHAR('\"',index);
-            UNITY_OUTPUT_CHAR('\n',index);
-            UnityPrint("\"Result\":\"\"",index);
-            UNITY_OUTPUT_CHAR('\n',index);
-            UnityPrint("\"Message\":\"\"",index);
-            UNITY_OUTPUT_CHAR('\n',index);
-            UNITY_OUTPUT_CHAR('}',index); 
+#endif
         }
     }
-    UNITY_IGNORE_AND_BAIL;
-}
 
-//-----------------------------------------------
-void setUp(void);
-void tearDown(void);
-void UnityDefaultTestRun(UnityTestFunction Func, const char* FuncName, const int FuncLineNum)
-{
-    Unity.CurrentTestName = FuncName;
-    Unity.CurrentTestLineNumber = FuncLineNum;
-    Unity.NumberOfTests++; 
-    if (TEST_PROTECT())
-    {
-        setUp();
-        Func();
-    }
-    if (TEST_PROTECT() && !(Unity.CurrentTestIgnored))
+    for (i = 0; i < poolSize; i++)
     {
-        tearDown();
+        if (pool[i].Pid > 0)
+            UnityForkRetire(&pool[i], &status);
     }
-    UnityConcludeTest();
+    signal(SIGPIPE, oldPipe);
+
+    UnityMergeResults(results, count);
+
+    free(order);
+    free(results);
+    free(polls);
+    free(pool);
+    if (tests != table)
+        free((void*)tests);
 }
+#endif
 
 //-----------------------------------------------
 void UnityBegin(void)
 {
+    const char* full_diff;
+    const char* shard;
+
     Unity.NumberOfTests = 0;
     Unity.TestFailures = 0;
     Unity.TestIgnores = 0;
     Unity.CurrentTestFailed = 0;
     Unity.CurrentTestIgnored = 0;
+    Unity.CurrentTestTimedOut = 0;
+    Unity.CurrentResult.Fields = Unity.CurrentFields;
+    full_diff = getenv("UNITY_FULL_DIFF");
+    if (full_diff != NULL)
+    {
+        UnityFullDiff = (atoi(full_diff) != 0);
+    }
+    // a --shard, --include or --exclude given to UnityParseOptions wins over the environment
+    shard = getenv("UNITY_SHARD");
+    if ((UnityShardCount == 0) && (shard != NULL) && (shard[0] != '\0'))
+    {
+        UnitySetShard(shard);
+    }
+    UnityReadFilters();
+    UnityReadHistory();
+#ifdef UNITY_SUPPORT_TIMEOUTS
+    UnityReadTimeout();
+#endif
+#ifdef UNITY_SUPPORT_CACHE
+    UnityCacheBegin();
+#endif
+#ifdef UNITY_SUPPORT_TIMING
+#if (UNITY_SLOWEST_TESTS > 0)
+    UnitySlowestCount = 0;
+#endif
+    UnityBaselineCount = 0;
+#endif
+#if (UNITY_RESULT_ARENA_SIZE > 0)
+    if (Unity.Arena == NULL)
+    {
+        Unity.Arena = &UnityDefaultArena;
+    }
+#endif
+    if (UnitySinkCount == 0)
+    {
+        UnityAddSink(&UnitySinkConsole);
+#ifdef UNITY_REPORT_BINARY
+        UnityAddSink(&UnitySinkBinary);
+#else
+        UnityAddSink(&UnitySinkJson);
+#endif
+#ifdef UNITY_REPORT_JUNIT
+        UnityAddSink(&UnitySinkJUnit);
+#endif
+    }
+#ifdef UNITY_REPORT_BINARY
+    // every session in the log starts with its own header
+    UnityBinaryStarted = 0;
+#endif
+#ifndef UNITY_EXCLUDE_CRASH_FLUSH
+    UnityInstallCrashFlush();
+#endif
 }
 
 //-----------------------------------------------
 int UnityEnd(void)
 {
-    _US32 index=1;
+    _US32 index=UNITY_CHANNEL_CONSOLE;
+#ifdef UNITY_SUPPORT_CACHE
+    if (UNITY_CACHE_REPLAYING())
+    {
+        UNITY_CRASH_FLUSH_REMOVE();
+        return UnityCacheReplay();
+    }
+#endif
+    UnityFlushResults();
+#ifdef UNITY_SUPPORT_TIMING
+    UnityCompareBaseline();
+#if (UNITY_SLOWEST_TESTS > 0)
+    UnityPrintSlowest();
+#endif
+#endif
     UnityPrint("-----------------------",index);
     UNITY_PRINT_EOL;
     UnityPrintNumber(Unity.NumberOfTests,index);
@@ -1172,5 +6184,12 @@ int UnityEnd(void)
         UnityPrintFail();
     }
     UNITY_PRINT_EOL;
+    UnityCloseReport();
+    UnityCloseJUnit();
+    UNITY_CRASH_FLUSH_REMOVE();
+    UnityWriteHistory();
+#ifdef UNITY_SUPPORT_CACHE
+    UnityCacheStore(Unity.TestFailures);
+#endif
     return Unity.TestFailures;
 }
@@ -24,6 +24,8 @@
 //     - define UNITY_FLOAT_PRECISION to specify the precision to use when doing TEST_ASSERT_EQUAL_FLOAT
 //     - define UNITY_FLOAT_TYPE to specify doubles instead of single precision floats
 //     - define UNITY_FLOAT_VERBOSE to print floating point values in errors (uses sprintf)
+//     - the _ARRAY_WITHIN assertions take an absolute delta, a relative tolerance (_REL) or a distance in ULPs (_ULP)
+//     - where SSE2 is available, they skip the blocks that are all in tolerance.  Double _ULP arrays are always checked one element at a time
 //     - define UNITY_INCLUDE_DOUBLE to allow double floating point comparisons
 //     - define UNITY_EXCLUDE_DOUBLE to disallow double floating point comparisons (default)
 //     - define UNITY_DOUBLE_PRECISION to specify the precision to use when doing TEST_ASSERT_EQUAL_DOUBLE
@@ -32,10 +34,49 @@
 
 // Output
 //     - by default, Unity prints to standard out with putchar.  define UNITY_OUTPUT_CHAR(a) with a different function if desired
+//     - define UNITY_OUTPUT_SPAN(ptr,len,channel) to take runs of characters in one call
+//     - the JSON report is written to <TestFile>.json through a buffer of UNITY_REPORT_BUFFER_SIZE bytes (default 64k)
+//     - define UNITY_REPORT_JSON_LINES to write one JSON object per test and line to <TestFile>.jsonl instead
+//     - define UNITY_REPORT_BINARY to write a binary result log (<TestFile>.ulog) instead; unity_decode.c reads it back
+//     - define UNITY_REPORT_JUNIT (or add UnitySinkJUnit) to also write JUnit XML to <TestFile>.xml, which must be seekable to get each suite's totals
+//     - define UNITY_REPORT_MMAP (POSIX) to write the report through a memory mapping of the file
+//     - define UNITY_EXCLUDE_CRASH_FLUSH to stop Unity from catching crashes to write out the report
+//     - results go to the sinks added with UnityAddSink (console and JSON by default).  define UNITY_MAX_SINKS to allow more than 4
+//     - each test is reported as it ends.  With UNITY_EXCLUDE_CRASH_FLUSH, results are queued and reported in batches of UNITY_RESULT_BATCH_SIZE
+//     - long strings that differ are shown UNITY_STRING_EXCERPT characters (default 24) either side of the first difference
+//     - _STRING_LEN compares at most len characters but stops where both strings end, so like _STRING it still looks for their terminators
+//     - set UnityFullDiff (or UNITY_FULL_DIFF) to have array and memory failures list every run of differing elements
 
 // Optimization
 //     - by default, line numbers are stored in unsigned shorts.  Define UNITY_LINE_TYPE with a different type if your files are huge
 //     - by default, test and failure counters are unsigned shorts.  Define UNITY_COUNTER_TYPE with a different type if you want to save space or have more than 65535 Tests.
+//     - define UNITY_EXCLUDE_INLINE_ASSERTS to call Unity for every assertion rather than only for failures
+//     - define UNITY_EXCLUDE_SIMD to compare memory without SSE2/AVX2
+
+// Timing
+//     - define UNITY_SUPPORT_TIMING to time setUp, the test and tearDown of every test
+//     - define UNITY_CLOCK_NS() and UNITY_CPU_CLOCK_NS() to use your own clocks rather than the POSIX ones
+//     - UnityEnd lists the UNITY_SLOWEST_TESTS slowest tests (default 5, 0 turns the list off)
+//     - RUN_BENCHMARK(func, line) and TEST_BENCHMARK(func) time func over many calls; see UNITY_BENCHMARK_SAMPLES
+//     - set Unity.BaselineFile (or UNITY_BASELINE) to an earlier JSON report to fail benchmarks that got slower
+
+// Parallel Tests
+//     - define UNITY_SUPPORT_THREADS (and link with -pthread) to run a table of UNITY_TEST_ENTRY()s on threads with RUN_TESTS_PARALLEL
+//     - define UNITY_SUPPORT_FORK (POSIX) to run it in worker processes with RUN_TESTS_FORKED; see UNITY_FORK_TIMEOUT_MS
+//     - set Unity.HistoryFile (--history, UNITY_HISTORY) to run recently failing and slow tests first
+
+// Test Selection
+//     - pass argc/argv to UnityParseOptions to take --shard INDEX/COUNT, --include and --exclude (or UNITY_SHARD, UNITY_INCLUDE, UNITY_EXCLUDE)
+//     - unity_merge.c adds up the output of several shards into one summary
+
+// Result Cache
+//     - define UNITY_SUPPORT_CACHE (Linux) and set Unity.CacheDir (--cache, UNITY_CACHE) to replay runs that cannot have changed
+//     - list the files a run reads in Unity.CacheInputs (--cache-inputs, UNITY_CACHE_INPUTS); see UNITY_CACHE_SIZE
+
+// Test Timeouts
+//     - define UNITY_SUPPORT_TIMEOUTS (POSIX) to fail tests that run longer than UNITY_TEST_TIMEOUT_MS (or the environment variable)
+//     - TEST_TIMEOUT_MS(ms) at the top of a test gives that test its own limit
+//     - RUN_TESTS_PARALLEL workers are timed out on Linux only, where each thread can have its own timer
 
 // Test Cases
 //     - define UNITY_SUPPORT_TEST_CASES to include the TEST_CASE macro, though really it's mostly about the runner generator script
@@ -55,9 +96,36 @@
 #define RUN_TEST(func, line_num) UnityDefaultTestRun(func, #func, line_num)
 #endif
 
+#define UNITY_TEST_ENTRY(func, line_num) { func, #func, line_num }
+
+#ifdef UNITY_SUPPORT_THREADS
+#define RUN_TESTS_PARALLEL(tests, workers) UnityParallelTestRun(tests, (_UU32)(sizeof(tests) / sizeof((tests)[0])), workers)
+#endif
+
+#ifdef UNITY_SUPPORT_TIMING
+#define RUN_BENCHMARK(func, line_num) UnityDefaultBenchmarkRun(func, #func, line_num)
+#define TEST_BENCHMARK(func) UnityBenchmark(func)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define UNITY_DO_NOT_OPTIMIZE(value) __asm__ __volatile__("" : : "r,m"(value) : "memory")
+#else
+#define UNITY_DO_NOT_OPTIMIZE(value) (UnityOptimizerSink = (const void*)&(value))
+#endif
+#endif
+
+#ifdef UNITY_SUPPORT_FORK
+#define RUN_TESTS_FORKED(tests, workers) UnityForkedTestRun(tests, (_UU32)(sizeof(tests) / sizeof((tests)[0])), workers)
+#endif
+
 #define TEST_LINE_NUM (Unity.CurrentTestLineNumber)
 #define TEST_IS_IGNORED (Unity.CurrentTestIgnored)
 
+#ifdef UNITY_SUPPORT_TIMEOUTS
+#define TEST_TIMEOUT_MS(ms) UnitySetTestTimeout(ms)
+#else
+#define TEST_TIMEOUT_MS(ms)
+#endif
+
 //-------------------------------------------------------
 // Basic Fail and Ignore
 //-------------------------------------------------------
@@ -116,6 +184,7 @@
 //Structs and Strings
 #define TEST_ASSERT_EQUAL_PTR(expected, actual)                                                    UNITY_TEST_ASSERT_EQUAL_PTR((expected), (actual), __LINE__, NULL)
 #define TEST_ASSERT_EQUAL_STRING(expected, actual)                                                 UNITY_TEST_ASSERT_EQUAL_STRING(expected, actual, __LINE__, NULL)
+#define TEST_ASSERT_EQUAL_STRING_LEN(expected, actual, len)                                        UNITY_TEST_ASSERT_EQUAL_STRING_LEN(expected, actual, len, __LINE__, NULL)
 #define TEST_ASSERT_EQUAL_MEMORY(expected, actual, len)                                            UNITY_TEST_ASSERT_EQUAL_MEMORY(expected, actual, len, __LINE__, NULL)
 
 //Arrays
@@ -142,11 +211,17 @@
 #define TEST_ASSERT_FLOAT_WITHIN(delta, expected, actual)                                          UNITY_TEST_ASSERT_FLOAT_WITHIN(delta, expected, actual, __LINE__, NULL)
 #define TEST_ASSERT_EQUAL_FLOAT(expected, actual)                                                  UNITY_TEST_ASSERT_EQUAL_FLOAT(expected, actual, __LINE__, NULL)
 #define TEST_ASSERT_EQUAL_FLOAT_ARRAY(expected, actual, num_elements)                              UNITY_TEST_ASSERT_EQUAL_FLOAT_ARRAY(expected, actual, num_elements, __LINE__, NULL)
+#define TEST_ASSERT_FLOAT_ARRAY_WITHIN(delta, expected, actual, num_elements)                      UNITY_TEST_ASSERT_FLOAT_ARRAY_WITHIN(delta, UNITY_TOLERANCE_ABSOLUTE, expected, actual, num_elements, __LINE__, NULL)
+#define TEST_ASSERT_FLOAT_ARRAY_WITHIN_REL(ratio, expected, actual, num_elements)                  UNITY_TEST_ASSERT_FLOAT_ARRAY_WITHIN(ratio, UNITY_TOLERANCE_RELATIVE, expected, actual, num_elements, __LINE__, NULL)
+#define TEST_ASSERT_FLOAT_ARRAY_WITHIN_ULP(ulps, expected, actual, num_elements)                   UNITY_TEST_ASSERT_FLOAT_ARRAY_WITHIN(ulps, UNITY_TOLERANCE_ULP, expected, actual, num_elements, __LINE__, NULL)
 
 //Double (If Enabled)
 #define TEST_ASSERT_DOUBLE_WITHIN(delta, expected, actual)                                         UNITY_TEST_ASSERT_DOUBLE_WITHIN(delta, expected, actual, __LINE__, NULL)
 #define TEST_ASSERT_EQUAL_DOUBLE(expected, actual)                                                 UNITY_TEST_ASSERT_EQUAL_DOUBLE(expected, actual, __LINE__, NULL)
 #define TEST_ASSERT_EQUAL_DOUBLE_ARRAY(expected, actual, num_elements)                             UNITY_TEST_ASSERT_EQUAL_DOUBLE_ARRAY(expected, actual, num_elements, __LINE__, NULL)
+#define TEST_ASSERT_DOUBLE_ARRAY_WITHIN(delta, expected, actual, num_elements)                     UNITY_TEST_ASSERT_DOUBLE_ARRAY_WITHIN(delta, UNITY_TOLERANCE_ABSOLUTE, expected, actual, num_elements, __LINE__, NULL)
+#define TEST_ASSERT_DOUBLE_ARRAY_WITHIN_REL(ratio, expected, actual, num_elements)                 UNITY_TEST_ASSERT_DOUBLE_ARRAY_WITHIN(ratio, UNITY_TOLERANCE_RELATIVE, expected, actual, num_elements, __LINE__, NULL)
+#define TEST_ASSERT_DOUBLE_ARRAY_WITHIN_ULP(ulps, expected, actual, num_elements)                  UNITY_TEST_ASSERT_DOUBLE_ARRAY_WITHIN(ulps, UNITY_TOLERANCE_ULP, expected, actual, num_elements, __LINE__, NULL)
 
 
 //-------------------------------------------------------
@@ -197,6 +272,7 @@
 //Structs and Strings
 #define TEST_ASSERT_EQUAL_PTR_MESSAGE(expected, actual, message)                                   UNITY_TEST_ASSERT_EQUAL_PTR(expected, actual, __LINE__, message)
 #define TEST_ASSERT_EQUAL_STRING_MESSAGE(expected, actual, message)                                UNITY_TEST_ASSERT_EQUAL_STRING(expected, actual, __LINE__, message)
+#define TEST_ASSERT_EQUAL_STRING_LEN_MESSAGE(expected, actual, len, message)                       UNITY_TEST_ASSERT_EQUAL_STRING_LEN(expected, actual, len, __LINE__, message)
 #define TEST_ASSERT_EQUAL_MEMORY_MESSAGE(expected, actual, len, message)                           UNITY_TEST_ASSERT_EQUAL_MEMORY(expected, actual, len, __LINE__, message)
 
 //Arrays
@@ -223,10 +299,16 @@
 #define TEST_ASSERT_FLOAT_WITHIN_MESSAGE(delta, expected, actual, message)                         UNITY_TEST_ASSERT_FLOAT_WITHIN(delta, expected, actual, __LINE__, message)
 #define TEST_ASSERT_EQUAL_FLOAT_MESSAGE(expected, actual, message)                                 UNITY_TEST_ASSERT_EQUAL_FLOAT(expected, actual, __LINE__, message)
 #define TEST_ASSERT_EQUAL_FLOAT_ARRAY_MESSAGE(expected, actual, num_elements, message)             UNITY_TEST_ASSERT_EQUAL_FLOAT_ARRAY(expected, actual, num_elements, __LINE__, message)
+#define TEST_ASSERT_FLOAT_ARRAY_WITHIN_MESSAGE(delta, expected, actual, num_elements, message)     UNITY_TEST_ASSERT_FLOAT_ARRAY_WITHIN(delta, UNITY_TOLERANCE_ABSOLUTE, expected, actual, num_elements, __LINE__, message)
+#define TEST_ASSERT_FLOAT_ARRAY_WITHIN_REL_MESSAGE(ratio, expected, actual, num_elements, message) UNITY_TEST_ASSERT_FLOAT_ARRAY_WITHIN(ratio, UNITY_TOLERANCE_RELATIVE, expected, actual, num_elements, __LINE__, message)
+#define TEST_ASSERT_FLOAT_ARRAY_WITHIN_ULP_MESSAGE(ulps, expected, actual, num_elements, message)  UNITY_TEST_ASSERT_FLOAT_ARRAY_WITHIN(ulps, UNITY_TOLERANCE_ULP, expected, actual, num_elements, __LINE__, message)
 
 //Double (If Enabled)
 #define TEST_ASSERT_DOUBLE_WITHIN_MESSAGE(delta, expected, actual, message)                        UNITY_TEST_ASSERT_DOUBLE_WITHIN(delta, expected, actual, __LINE__, message)
 #define TEST_ASSERT_EQUAL_DOUBLE_MESSAGE(expected, actual, message)                                UNITY_TEST_ASSERT_EQUAL_DOUBLE(expected, actual, __LINE__, message)
 #define TEST_ASSERT_EQUAL_DOUBLE_ARRAY_MESSAGE(expected, actual, num_elements, message)            UNITY_TEST_ASSERT_EQUAL_DOUBLE_ARRAY(expected, actual, num_elements, __LINE__, message)
+#define TEST_ASSERT_DOUBLE_ARRAY_WITHIN_MESSAGE(delta, expected, actual, num_elements, message)    UNITY_TEST_ASSERT_DOUBLE_ARRAY_WITHIN(delta, UNITY_TOLERANCE_ABSOLUTE, expected, actual, num_elements, __LINE__, message)
+#define TEST_ASSERT_DOUBLE_ARRAY_WITHIN_REL_MESSAGE(ratio, expected, actual, num_elements, message) UNITY_TEST_ASSERT_DOUBLE_ARRAY_WITHIN(ratio, UNITY_TOLERANCE_RELATIVE, expected, actual, num_elements, __LINE__, message)
+#define TEST_ASSERT_DOUBLE_ARRAY_WITHIN_ULP_MESSAGE(ulps, expected, actual, num_elements, message) UNITY_TEST_ASSERT_DOUBLE_ARRAY_WITHIN(ulps, UNITY_TOLERANCE_ULP, expected, actual, num_elements, __LINE__, message)
 
 #endif
@@ -0,0 +1,399 @@
+/* ==========================================
+    Unity Project - A Test Framework for C
+    Copyright (c) 2007 Mike Karlesky, Mark VanderVoord, Greg Williams
+    [Released under MIT License. Please refer to license.txt for details]
+========================================== */
+
+// Reads the binary result log written with UNITY_REPORT_BINARY and replays
+// it through Unity's own sinks, so the output is what the run would have
+// printed.  Build it on the host with the options the tests were built with,
+// less UNITY_REPORT_BINARY:
+//
+//     cc -o unity_decode unity_decode.c unity.c
+//     unity_decode [--console | --json | --junit] test_file.c.ulog
+//
+// --console (the default) prints the results, --json writes the report
+// (<TestFile>.json, or .jsonl with UNITY_REPORT_JSON_LINES) and --junit writes
+// <TestFile>.xml, each followed by the summary.  The exit status is the number
+// of failures, like UnityEnd(), or 255 if the log cannot be read.
+
+#include "unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef UNITY_REPORT_BINARY
+#error "unity_decode writes the console, JSON and JUnit output; build it without UNITY_REPORT_BINARY"
+#endif
+
+// unity.c calls these around every test it runs; the decoder runs none
+void setUp(void) {}
+void tearDown(void) {}
+
+struct _UnityLog
+{
+    const unsigned char* At;
+    const unsigned char* End;
+    int Timed;
+    int Broken;
+
+    // every string read so far, NUL terminated, and the ones current ids refer to
+    char* Pool;
+    size_t PoolUsed;
+    const char** Strings;
+    unsigned long long StringCount;
+    unsigned long long StringCapacity;
+};
+
+typedef void (*UnityReplayFunction)(const struct _UnityResult* result);
+
+//-----------------------------------------------
+// Reading The Log
+//-----------------------------------------------
+
+static unsigned long long UnityLogNumber(struct _UnityLog* log)
+{
+    unsigned long long value = 0;
+    _UU32 shift = 0;
+
+    while (log->At < log->End)
+    {
+        const unsigned char byte = *log->At++;
+        if (shift < 64)
+            value |= (unsigned long long)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+            return value;
+        shift += 7;
+    }
+    log->Broken = 1;
+    return 0;
+}
+
+static _U_SINT UnityLogSigned(struct _UnityLog* log)
+{
+    const unsigned long long value = UnityLogNumber(log);
+
+    return (_U_SINT)(_U_UINT)((value & 1) ? ~(value >> 1) : (value >> 1));
+}
+
+//-----------------------------------------------
+static const char* UnityLogString(struct _UnityLog* log)
+{
+    const unsigned long long id = UnityLogNumber(log);
+
+    if (id == 0)
+        return NULL;
+    if (id > log->StringCount)
+    {
+        log->Broken = 1;
+        return NULL;
+    }
+    return log->Strings[id - 1];
+}
+
+//-----------------------------------------------
+static void UnityLogDefineString(struct _UnityLog* log)
+{
+    const unsigned long long id = UnityLogNumber(log);
+    const unsigned long long length = UnityLogNumber(log);
+    char* string;
+
+    // ids are handed out in order, starting from 1 after every reset
+    if (log->Broken || (id != log->StringCount + 1) || (length > (unsigned long long)(log->End - log->At)))
+    {
+        log->Broken = 1;
+        return;
+    }
+    if (log->StringCount == log->StringCapacity)
+    {
+        const unsigned long long capacity = (log->StringCapacity == 0) ? 256 : log->StringCapacity * 2;
+        const char** grown = (const char**)realloc((void*)log->Strings, (size_t)capacity * sizeof(const char*));
+        if (grown == NULL)
+        {
+            log->Broken = 1;
+            return;
+        }
+        log->Strings = grown;
+        log->StringCapacity = capacity;
+    }
+
+    string = &log->Pool[log->PoolUsed];
+    memcpy(string, log->At, (size_t)length);
+    string[length] = '\0';
+    log->PoolUsed += (size_t)length + 1;
+    log->At += length;
+    log->Strings[log->StringCount++] = string;
+}
+
+//-----------------------------------------------
+static void UnityLogField(struct _UnityLog* log, struct _UnityField* field, char* buffer)
+{
+    unsigned long long bits = 0;
+    double number;
+    _UU32 i;
+
+    memset(field, 0, sizeof(*field));
+    field->Kind = (UNITY_FIELD_T)UnityLogNumber(log);
+    field->Type = (UNITY_VALUE_T)UnityLogNumber(log);
+    switch (field->Type)
+    {
+        case UNITY_VALUE_NUMBER:
+            field->Style = (UNITY_DISPLAY_STYLE_T)UnityLogNumber(log);
+            field->Number = UnityLogSigned(log);
+            break;
+        case UNITY_VALUE_MASK:
+            field->Mask = UnityLogSigned(log);
+            field->Number = UnityLogSigned(log);
+            break;
+        case UNITY_VALUE_FLOAT:
+            // formatted here as UnityFormatFloat would, whether or not this build has UNITY_FLOAT_VERBOSE
+            if (log->End - log->At < 8)
+            {
+                log->Broken = 1;
+                break;
+            }
+            for (i = 0; i < 8; i++)
+            {
+                bits |= (unsigned long long)log->At[i] << (i * 8);
+            }
+            log->At += 8;
+            memcpy(&number, &bits, sizeof(number));
+            sprintf(buffer, "%.6f", number);
+            field->Type = UNITY_VALUE_TEXT;
+            field->String = buffer;
+            break;
+        case UNITY_VALUE_TEXT:
+        case UNITY_VALUE_STRING:
+            field->String = UnityLogString(log);
+            break;
+        default:
+            log->Broken = 1;
+            break;
+    }
+}
+
+//-----------------------------------------------
+static void UnityLogTest(struct _UnityLog* log, UnityReplayFunction replay)
+{
+    struct _UnityResult result;
+    struct _UnityField fields[UNITY_RESULT_MAX_FIELDS];
+    char buffers[UNITY_RESULT_MAX_FIELDS][UNITY_FIELD_TEXT_SIZE];
+    _UU32 i;
+
+    memset(&result, 0, sizeof(result));
+    result.File = Unity.TestFile;
+    result.TestName = UnityLogString(log);
+    result.TestLineNumber = (UNITY_LINE_TYPE)UnityLogNumber(log);
+    result.LineNumber = (UNITY_LINE_TYPE)UnityLogNumber(log);
+    result.Status = (UNITY_RESULT_T)UnityLogNumber(log);
+    result.FieldCount = (_UU32)UnityLogNumber(log);
+    result.Fields = fields;
+    if (result.FieldCount > UNITY_RESULT_MAX_FIELDS)
+    {
+        log->Broken = 1;
+        return;
+    }
+    for (i = 0; i < result.FieldCount; i++)
+    {
+        UnityLogField(log, &fields[i], buffers[i]);
+    }
+
+    if (log->Timed)
+    {
+        unsigned long long timing[UNITY_BINARY_PHASES + 1];
+        unsigned long long benchmark[6] = { 0, 0, 0, 0, 0, 0 };
+
+        for (i = 0; i <= UNITY_BINARY_PHASES; i++)
+        {
+            timing[i] = UnityLogNumber(log);
+        }
+        benchmark[1] = UnityLogNumber(log);
+        if (benchmark[1] > 0)
+        {
+            benchmark[0] = UnityLogNumber(log);
+            for (i = 2; i < 6; i++)
+            {
+                benchmark[i] = UnityLogNumber(log);
+            }
+        }
+#ifdef UNITY_SUPPORT_TIMING
+        for (i = 0; i < UNITY_PHASE_COUNT; i++)
+        {
+            result.Timing.Phase[i] = (_UT)timing[i];
+        }
+        result.Timing.Cpu = (_UT)timing[UNITY_BINARY_PHASES];
+        result.Benchmark.Iterations = (_UU32)benchmark[0];
+        result.Benchmark.Samples = (_UU32)benchmark[1];
+        result.Benchmark.Min = (_UT)benchmark[2];
+        result.Benchmark.Median = (_UT)benchmark[3];
+        result.Benchmark.P99 = (_UT)benchmark[4];
+        result.Benchmark.Stddev = (_UT)benchmark[5];
+#else
+        (void)timing;
+        (void)benchmark;
+#endif
+    }
+
+    if (log->Broken || (result.Status > UNITY_RESULT_TIMEOUT))
+    {
+        log->Broken = 1;
+        return;
+    }
+    replay(&result);
+}
+
+//-----------------------------------------------
+/// hand every test in the log to replay, in order; 0 if the log is malformed
+static int UnityLogReplay(struct _UnityLog* log, const unsigned char* data, const size_t size, UnityReplayFunction replay)
+{
+    log->At = data;
+    log->End = data + size;
+    log->Timed = 0;
+    log->Broken = 0;
+    log->PoolUsed = 0;
+    log->StringCount = 0;
+    Unity.TestFile = NULL;
+
+    while ((log->At < log->End) && !log->Broken)
+    {
+        // each session appended to the log starts with a header
+        if ((log->End - log->At >= 6) && (memcmp(log->At, UNITY_BINARY_MAGIC, 4) == 0))
+        {
+            if (log->At[4] != UNITY_BINARY_VERSION)
+                return 0;
+            log->Timed = ((log->At[5] & UNITY_BINARY_TIMED) != 0);
+            log->StringCount = 0;
+            log->At += 6;
+            continue;
+        }
+
+        switch (*log->At++)
+        {
+            case UNITY_BINARY_STRING:
+                UnityLogDefineString(log);
+                break;
+            case UNITY_BINARY_TEST:
+                UnityLogTest(log, replay);
+                break;
+            case UNITY_BINARY_FILE:
+                // each record's JSON goes to the report named after its test file
+                Unity.TestFile = UnityLogString(log);
+                break;
+            case UNITY_BINARY_RESET:
+                UnityLogNumber(log);
+                log->StringCount = 0;
+                break;
+            default:
+                log->Broken = 1;
+                break;
+        }
+    }
+    return !log->Broken;
+}
+
+//-----------------------------------------------
+// Replaying Results
+//-----------------------------------------------
+
+static void UnityReplayResult(const struct _UnityResult* result)
+{
+    Unity.NumberOfTests++;
+    if ((result->Status == UNITY_RESULT_FAIL) || (result->Status == UNITY_RESULT_TIMEOUT))
+        Unity.TestFailures++;
+    else if (result->Status == UNITY_RESULT_IGNORE)
+        Unity.TestIgnores++;
+    UnityReportResult(result);
+}
+
+//-----------------------------------------------
+static unsigned char* UnityReadLog(const char* path, size_t* size)
+{
+    unsigned char* data = NULL;
+    size_t capacity = 0;
+    size_t got;
+    FILE* file = fopen(path, "rb");
+
+    *size = 0;
+    if (file == NULL)
+        return NULL;
+    do
+    {
+        if (*size == capacity)
+        {
+            unsigned char* grown;
+            capacity = (capacity == 0) ? 65536 : capacity * 2;
+            grown = (unsigned char*)realloc(data, capacity);
+            if (grown == NULL)
+            {
+                free(data);
+                fclose(file);
+                return NULL;
+            }
+            data = grown;
+        }
+        got = fread(&data[*size], 1, capacity - *size, file);
+        *size += got;
+    } while (got > 0);
+    fclose(file);
+    return data;
+}
+
+//-----------------------------------------------
+int main(int argc, char** argv)
+{
+    const char* mode = "--console";
+    const char* path = NULL;
+    struct _UnityLog log;
+    unsigned char* data;
+    size_t size;
+    int i, ok;
+
+    for (i = 1; i < argc; i++)
+    {
+        if ((strcmp(argv[i], "--console") == 0) || (strcmp(argv[i], "--json") == 0) || (strcmp(argv[i], "--junit") == 0))
+            mode = argv[i];
+        else
+            path = argv[i];
+    }
+    if (path == NULL)
+    {
+        fprintf(stderr, "usage: %s [--console | --json | --junit] <TestFile>.ulog\n", argv[0]);
+        return 255;
+    }
+
+    data = UnityReadLog(path, &size);
+    memset(&log, 0, sizeof(log));
+    // no string in the log can be longer than the log
+    log.Pool = (char*)malloc(size + 1);
+    if ((data == NULL) || (log.Pool == NULL))
+    {
+        fprintf(stderr, "%s: cannot read %s\n", argv[0], path);
+        free(data);
+        free(log.Pool);
+        return 255;
+    }
+
+    Unity.NumberOfTests = 0;
+    Unity.TestFailures = 0;
+    Unity.TestIgnores = 0;
+    UnityClearSinks();
+    if (strcmp(mode, "--json") == 0)
+        UnityAddSink(&UnitySinkJson);
+    else if (strcmp(mode, "--junit") == 0)
+        UnityAddSink(&UnitySinkJUnit);
+    else
+        UnityAddSink(&UnitySinkConsole);
+    ok = UnityLogReplay(&log, data, size, UnityReplayResult);
+    if (ok)
+        UnityEnd();
+
+    free((void*)log.Strings);
+    free(log.Pool);
+    free(data);
+    if (!ok)
+    {
+        fprintf(stderr, "%s: %s is not a Unity result log, or is cut short\n", argv[0], path);
+        return 255;
+    }
+    return Unity.TestFailures;
+}
@@ -234,12 +234,141 @@ typedef UNITY_DOUBLE_TYPE _UD;
 // Output Method
 //-------------------------------------------------------
 
+//Output channels: the JSON report file and the console
+#define UNITY_CHANNEL_JSON     (0)
+#define UNITY_CHANNEL_CONSOLE  (1)
+
 #ifndef UNITY_OUTPUT_CHAR
 //Default to using putchar, which is defined in stdio.h above
 #define UNITY_OUTPUT_CHAR(a,i) put_char(a,i)
+int put_char(int a, _US32 index);
+//and to writing runs of characters that need no escaping straight into stdout's or the report's buffer
+#ifndef UNITY_OUTPUT_SPAN
+#define UNITY_OUTPUT_SPAN(s,n,i) put_span(s,n,i)
+int put_span(const char* text, _UU32 length, _US32 index);
+#endif
 #else
 //If defined as something else, make sure we declare it here so it's ready for use
 extern int UNITY_OUTPUT_CHAR(int,int);
+#ifdef UNITY_SUPPORT_CACHE
+#error UNITY_SUPPORT_CACHE records what Unity writes through its own UNITY_OUTPUT_CHAR
+#endif
+#endif
+
+//The JSON report is written through a user-space buffer of this many bytes
+#ifndef UNITY_REPORT_BUFFER_SIZE
+#define UNITY_REPORT_BUFFER_SIZE (65536)
+#endif
+
+//With UNITY_REPORT_MMAP (POSIX) the report is instead mapped into memory, reserved this many bytes at a time
+#ifndef UNITY_REPORT_MMAP_CHUNK
+#define UNITY_REPORT_MMAP_CHUNK (4194304)
+#endif
+
+//-------------------------------------------------------
+// Threads
+//-------------------------------------------------------
+
+// With UNITY_SUPPORT_THREADS every thread gets its own Unity context
+#ifdef UNITY_SUPPORT_THREADS
+  #ifndef UNITY_THREAD_LOCAL
+    #if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+      #define UNITY_THREAD_LOCAL _Thread_local
+    #elif defined(_MSC_VER)
+      #define UNITY_THREAD_LOCAL __declspec(thread)
+    #else
+      #define UNITY_THREAD_LOCAL __thread
+    #endif
+  #endif
+#else
+  #undef UNITY_THREAD_LOCAL
+  #define UNITY_THREAD_LOCAL
+#endif
+
+// Forked tests that run longer than this many milliseconds are killed (0 disables the limit)
+#ifndef UNITY_FORK_TIMEOUT_MS
+#define UNITY_FORK_TIMEOUT_MS (60000)
+#endif
+
+// With UNITY_SUPPORT_TIMEOUTS (POSIX) a test is failed once it has run this many milliseconds (0 for no limit),
+// interrupted by this signal
+#ifndef UNITY_TEST_TIMEOUT_MS
+#define UNITY_TEST_TIMEOUT_MS (0)
+#endif
+#ifndef UNITY_TIMEOUT_SIGNAL
+#define UNITY_TIMEOUT_SIGNAL SIGALRM
+#endif
+
+//-------------------------------------------------------
+// Timing
+//-------------------------------------------------------
+
+// With UNITY_SUPPORT_TIMING every test records how long setUp, the test and tearDown took
+#ifdef UNITY_SUPPORT_TIMING
+#ifndef UNITY_TIME_TYPE
+#define UNITY_TIME_TYPE unsigned long long
+#endif
+typedef UNITY_TIME_TYPE _UT;
+
+// UnityEnd lists this many of the slowest tests (0 turns the list off)
+#ifndef UNITY_SLOWEST_TESTS
+#define UNITY_SLOWEST_TESTS (5)
+#endif
+
+typedef enum
+{
+    UNITY_PHASE_SETUP = 0,
+    UNITY_PHASE_TEST,
+    UNITY_PHASE_TEARDOWN,
+    UNITY_PHASE_COUNT
+} UNITY_PHASE_T;
+
+// all times are in nanoseconds
+struct _UnityTiming
+{
+    _UT Phase[UNITY_PHASE_COUNT];
+    _UT Cpu;
+};
+
+// A benchmark is timed in UNITY_BENCHMARK_SAMPLES batches after UNITY_BENCHMARK_WARMUP
+// untimed ones, with the batch size calibrated so all samples take about UNITY_BENCHMARK_TARGET_NS
+#ifndef UNITY_BENCHMARK_SAMPLES
+#define UNITY_BENCHMARK_SAMPLES (50)
+#endif
+
+#ifndef UNITY_BENCHMARK_WARMUP
+#define UNITY_BENCHMARK_WARMUP (5)
+#endif
+
+#ifndef UNITY_BENCHMARK_TARGET_NS
+#define UNITY_BENCHMARK_TARGET_NS (100000000)
+#endif
+
+// UnityEnd compares benchmark medians with a baseline report. A median is only a regression
+// (or an improvement) if it moved by more than UNITY_BASELINE_TOLERANCE percent and by more
+// than UNITY_BASELINE_NOISE standard deviations of the noisier of the two runs
+#ifndef UNITY_BASELINE_TOLERANCE
+#define UNITY_BASELINE_TOLERANCE (10)
+#endif
+
+#ifndef UNITY_BASELINE_NOISE
+#define UNITY_BASELINE_NOISE (3)
+#endif
+
+#ifndef UNITY_BASELINE_MAX_BENCHMARKS
+#define UNITY_BASELINE_MAX_BENCHMARKS (64)
+#endif
+
+// statistics are in picoseconds per iteration; Samples is 0 if the test was no benchmark
+struct _UnityBenchmark
+{
+    _UU32 Iterations;
+    _UU32 Samples;
+    _UT Min;
+    _UT Median;
+    _UT P99;
+    _UT Stddev;
+};
 #endif
 
 //-------------------------------------------------------
@@ -260,6 +389,13 @@ extern int UNITY_OUTPUT_CHAR(int,int);
 
 typedef void (*UnityTestFunction)(void);
 
+typedef struct _UnityTestEntry
+{
+    UnityTestFunction Func;
+    const char* FuncName;
+    int FuncLineNum;
+} UnityTestEntry;
+
 #define UNITY_DISPLAY_RANGE_INT  (0x10)
 #define UNITY_DISPLAY_RANGE_UINT (0x20)
 #define UNITY_DISPLAY_RANGE_HEX  (0x40)
@@ -303,6 +439,191 @@ typedef enum
     UNITY_DISPLAY_STYLE_UNKNOWN
 } UNITY_DISPLAY_STYLE_T;
 
+// How a floating point array tolerance is measured
+typedef enum
+{
+    UNITY_TOLERANCE_ABSOLUTE = 0,
+    UNITY_TOLERANCE_RELATIVE,
+    UNITY_TOLERANCE_ULP
+} UNITY_TOLERANCE_T;
+
+// Full diff: array and memory failures list every differing run instead of only the first mismatch
+#ifndef UNITY_FULL_DIFF
+#define UNITY_FULL_DIFF (0)
+#endif
+
+//runs listed before the rest are only counted
+#ifndef UNITY_DIFF_MAX_RANGES
+#define UNITY_DIFF_MAX_RANGES (8)
+#endif
+
+extern int UnityFullDiff;
+
+// Sharding: run only the tests whose file and name hash to UnityShardIndex of UnityShardCount
+extern _UU32 UnityShardIndex;
+extern _UU32 UnityShardCount;
+
+//names and wildcard patterns each list of --include/--exclude patterns can hold, and the bytes for all of them
+#ifndef UNITY_FILTER_MAX_PATTERNS
+#define UNITY_FILTER_MAX_PATTERNS (64)
+#endif
+#ifndef UNITY_FILTER_TEXT_SIZE
+#define UNITY_FILTER_TEXT_SIZE (4096)
+#endif
+
+//With UNITY_SUPPORT_CACHE (POSIX) finished runs are kept in a cache directory trimmed back to this many bytes
+#ifndef UNITY_CACHE_SIZE
+#define UNITY_CACHE_SIZE (67108864)
+#endif
+
+//characters shown either side of the first difference when a long string fails
+#ifndef UNITY_STRING_EXCERPT
+#define UNITY_STRING_EXCERPT (24)
+#endif
+
+//-------------------------------------------------------
+// Test Results
+//-------------------------------------------------------
+//  Each test outcome is captured once as a _UnityResult and
+//  handed to every registered sink.  A failure is described
+//  by an ordered list of fields (element, expected, actual,
+//  ...) which are formatted to text once before fan-out.
+
+#ifndef UNITY_RESULT_MAX_FIELDS
+#define UNITY_RESULT_MAX_FIELDS (8)
+#endif
+
+//records, fields and string bytes held back before reporting; an arena size of 0 reports immediately
+#ifndef UNITY_RESULT_ARENA_SIZE
+#define UNITY_RESULT_ARENA_SIZE (64)
+#endif
+#ifndef UNITY_RESULT_ARENA_FIELDS
+#define UNITY_RESULT_ARENA_FIELDS (UNITY_RESULT_ARENA_SIZE * 2)
+#endif
+#ifndef UNITY_RESULT_ARENA_STRINGS
+#define UNITY_RESULT_ARENA_STRINGS (4096)
+#endif
+//results reported together; only with UNITY_EXCLUDE_CRASH_FLUSH, as the crash flush needs each test reported as it ends
+#ifndef UNITY_RESULT_BATCH_SIZE
+#define UNITY_RESULT_BATCH_SIZE UNITY_RESULT_ARENA_SIZE
+#endif
+
+#ifndef UNITY_MAX_SINKS
+#define UNITY_MAX_SINKS (4)
+#endif
+
+//large enough for any formatted number, mask or float
+#ifndef UNITY_FIELD_TEXT_SIZE
+#define UNITY_FIELD_TEXT_SIZE (72)
+#endif
+
+typedef enum
+{
+    UNITY_RESULT_PASS = 0,
+    UNITY_RESULT_FAIL,
+    UNITY_RESULT_IGNORE,
+    UNITY_RESULT_TIMEOUT    // a failure, reported apart in the JSON report
+} UNITY_RESULT_T;
+
+typedef enum
+{
+    UNITY_FIELD_DETAIL = 0,
+    UNITY_FIELD_ELEMENT,
+    UNITY_FIELD_BYTE,
+    UNITY_FIELD_DELTA,
+    UNITY_FIELD_EXPECTED,
+    UNITY_FIELD_ACTUAL,
+    UNITY_FIELD_MESSAGE
+} UNITY_FIELD_T;
+
+typedef enum
+{
+    UNITY_VALUE_TEXT = 0,
+    UNITY_VALUE_NUMBER,
+    UNITY_VALUE_MASK,
+    UNITY_VALUE_STRING,
+    UNITY_VALUE_FLOAT
+} UNITY_VALUE_T;
+
+struct _UnityField
+{
+    UNITY_FIELD_T Kind;
+    UNITY_VALUE_T Type;
+    UNITY_DISPLAY_STYLE_T Style;
+    _U_SINT Number;
+    _U_SINT Mask;
+    const char* String;
+#ifdef UNITY_FLOAT_VERBOSE
+    _UF Float;
+#endif
+};
+
+struct _UnityResult
+{
+    const char* File;           // Unity.TestFile when the test ran
+    const char* TestName;
+    UNITY_LINE_TYPE TestLineNumber;
+    UNITY_LINE_TYPE LineNumber;
+    UNITY_RESULT_T Status;
+    _UU32 FieldCount;
+    const struct _UnityField* Fields;
+#ifdef UNITY_SUPPORT_TIMING
+    struct _UnityTiming Timing;
+    struct _UnityBenchmark Benchmark;
+#endif
+};
+
+// Finished results are queued here and reported in one pass at
+// UnityEnd, at UnityFlushResults, or whenever BatchSize records
+// are waiting.  Strings are copied in, so records never point
+// into a test's stack frame.
+struct _UnityArena
+{
+    struct _UnityResult* Results;
+    struct _UnityField* Fields;
+    char* Strings;
+    _UU32 ResultCapacity;
+    _UU32 FieldCapacity;
+    _UU32 StringCapacity;
+    _UU32 ResultCount;
+    _UU32 FieldCount;
+    _UU32 StringCount;
+    _UU32 BatchSize;
+};
+
+// Output sink: called once per test with the finished result.
+// text is the field value already formatted (numbers, masks, etc),
+// or NULL for a sink with RawFields set, which records the values.
+struct _UnitySink
+{
+    void (*BeginTest)(const struct _UnityResult* result);
+    void (*Field)(const struct _UnityField* field, const char* text);
+    void (*EndTest)(const struct _UnityResult* result);
+    int RawFields;
+};
+
+// Binary result log (UNITY_REPORT_BINARY), read back by unity_decode.c.
+// After a header of the magic, the version and flags, every record is a
+// tag followed by LEB128 varints (zigzag encoded where signed).  Strings
+// are written once and then referred to by id; id 0 is NULL.
+#define UNITY_BINARY_MAGIC    "UNTY"
+#define UNITY_BINARY_VERSION  (1)
+#define UNITY_BINARY_TIMED    (0x01)    // test records end with setUp, test, tearDown and CPU times, then the benchmark
+#define UNITY_BINARY_PHASES   (3)
+
+typedef enum
+{
+    UNITY_BINARY_STRING = 1,    // id, length, bytes
+    UNITY_BINARY_TEST,          // name, test line, line, status, field count, fields[, timing]
+    UNITY_BINARY_FILE,          // Unity.TestFile for the records that follow
+    UNITY_BINARY_RESET          // forget every string id
+} UNITY_BINARY_TAG_T;
+
+//strings remembered by the writer before it starts its table over
+#ifndef UNITY_BINARY_STRINGS
+#define UNITY_BINARY_STRINGS (256)
+#endif
+
 struct _Unity
 {
     const char* TestFile;
@@ -313,10 +634,38 @@ struct _Unity
     UNITY_COUNTER_TYPE TestIgnores;
     UNITY_COUNTER_TYPE CurrentTestFailed;
     UNITY_COUNTER_TYPE CurrentTestIgnored;
+    UNITY_COUNTER_TYPE CurrentTestTimedOut;
+    struct _UnityResult CurrentResult;
+    struct _UnityField CurrentFields[UNITY_RESULT_MAX_FIELDS];
+    char CurrentStrings[UNITY_RESULT_MAX_FIELDS * UNITY_FIELD_TEXT_SIZE];
+    _UU32 CurrentStringCount;
+#ifdef UNITY_SUPPORT_TIMING
+    struct _UnityTiming CurrentTiming;
+    UNITY_PHASE_T CurrentPhase;
+    _UT PhaseStarted;
+    _UT CpuStarted;
+    struct _UnityBenchmark CurrentBenchmark;
+    UnityTestFunction BenchmarkFunction;
+    const char* BaselineFile;
+#endif
+    const char* HistoryFile;
+#ifdef UNITY_SUPPORT_CACHE
+    const char* CacheDir;
+    const char* CacheInputs;
+#endif
+    struct _UnityArena* Arena;
     jmp_buf AbortFrame;
 };
 
-extern struct _Unity Unity;
+extern UNITY_THREAD_LOCAL struct _Unity Unity;
+
+extern const struct _UnitySink UnitySinkConsole;
+extern const struct _UnitySink UnitySinkJson;
+extern const struct _UnitySink UnitySinkNone;
+extern const struct _UnitySink UnitySinkJUnit;
+#ifdef UNITY_REPORT_BINARY
+extern const struct _UnitySink UnitySinkBinary;
+#endif
 
 //-------------------------------------------------------
 // Test Suite Management
@@ -324,13 +673,51 @@ extern struct _Unity Unity;
 
 void UnityBegin(void);
 int  UnityEnd(void);
+int  UnityParseOptions(int argc, char* argv[]);
 void UnityConcludeTest(void);
 void UnityDefaultTestRun(UnityTestFunction Func, const char* FuncName, const int FuncLineNum);
 
+#ifdef UNITY_SUPPORT_THREADS
+void UnityParallelTestRun(const UnityTestEntry* tests, const _UU32 count, const _UU32 workers);
+#endif
+
+#ifdef UNITY_SUPPORT_FORK
+void UnityForkedTestRun(const UnityTestEntry* tests, const _UU32 count, const _UU32 workers);
+#endif
+
+#ifdef UNITY_SUPPORT_TIMEOUTS
+void UnitySetTestTimeout(const _UU32 ms);
+
+extern _UU32 UnityTestTimeout;
+#endif
+
+#ifdef UNITY_SUPPORT_TIMING
+void UnityBenchmark(UnityTestFunction Func);
+void UnityDefaultBenchmarkRun(UnityTestFunction Func, const char* FuncName, const int FuncLineNum);
+
+extern const void* volatile UnityOptimizerSink;
+#endif
+
+//-------------------------------------------------------
+// Result Sinks
+//-------------------------------------------------------
+//  If no sink is added before UnityBegin, the console and
+//  JSON sinks are used.  Add UnitySinkNone to report nothing.
+
+void UnityAddSink(const struct _UnitySink* sink);
+void UnityClearSinks(void);
+void UnityReportResult(const struct _UnityResult* result);
+void UnityCommitResult(const struct _UnityResult* result);
+void UnityFlushResults(void);
+
 //-------------------------------------------------------
 // Test Output
 //-------------------------------------------------------
 
+void UnityOpenReport(void);
+void UnityFlushReport(void);
+void UnityCloseReport(void);
+
 void UnityPrint(const char* string,int index);
 void UnityPrintMask(const _U_UINT mask, const _U_UINT number,int index);
 void UnityPrintNumberByStyle(const _U_SINT number, const UNITY_DISPLAY_STYLE_T style,int index);
@@ -338,8 +725,51 @@ void UnityPrintNumber(const _U_SINT number,int index);
 void UnityPrintNumberUnsigned(const _U_UINT number,int index);
 void UnityPrintNumberHex(const _U_UINT number, const char nibbles,int index);
 
+_UU32 UnityFormatMask(char* buffer, const _U_UINT mask, const _U_UINT number);
+_UU32 UnityFormatNumberByStyle(char* buffer, const _U_SINT number, const UNITY_DISPLAY_STYLE_T style);
+_UU32 UnityFormatNumber(char* buffer, const _U_SINT number);
+_UU32 UnityFormatNumberUnsigned(char* buffer, const _U_UINT number);
+_UU32 UnityFormatNumberHex(char* buffer, const _U_UINT number, const char nibbles);
+
 #ifdef UNITY_FLOAT_VERBOSE
 void UnityPrintFloat(const _UF number,int index);
+_UU32 UnityFormatFloat(char* buffer, const _UF number);
+#endif
+
+//-------------------------------------------------------
+// Compiler Hints
+//-------------------------------------------------------
+
+//assertions are expected to pass, and their failure paths are kept out of the way
+#ifndef UNITY_LIKELY
+#if defined(__GNUC__) || defined(__clang__)
+#define UNITY_LIKELY(condition)   __builtin_expect(!!(condition), 1)
+#define UNITY_UNLIKELY(condition) __builtin_expect(!!(condition), 0)
+#else
+#define UNITY_LIKELY(condition)   (condition)
+#define UNITY_UNLIKELY(condition) (condition)
+#endif
+#endif
+
+#ifndef UNITY_COLD
+#if defined(__clang__) || (defined(__GNUC__) && ((__GNUC__ > 4) || ((__GNUC__ == 4) && (__GNUC_MINOR__ >= 3))))
+#define UNITY_COLD __attribute__((cold, noinline))
+#elif defined(_MSC_VER)
+#define UNITY_COLD __declspec(noinline)
+#else
+#define UNITY_COLD
+#endif
+#endif
+
+//define UNITY_EXCLUDE_INLINE_ASSERTS (or use a compiler without inline functions) to call unity.c for every assertion
+#if !defined(UNITY_INLINE) && !defined(UNITY_EXCLUDE_INLINE_ASSERTS)
+#if defined(__GNUC__) || defined(__clang__)
+#define UNITY_INLINE static __inline__
+#elif defined(_MSC_VER)
+#define UNITY_INLINE static __inline
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 199901L)
+#define UNITY_INLINE static inline
+#endif
 #endif
 
 //-------------------------------------------------------
@@ -374,6 +804,12 @@ void UnityAssertEqualString(const char* expected,
                             const char* msg,
                             const UNITY_LINE_TYPE lineNumber);
 
+void UnityAssertEqualStringLen(const char* expected,
+                               const char* actual,
+                               const _UU32 length,
+                               const char* msg,
+                               const UNITY_LINE_TYPE lineNumber);
+
 void UnityAssertEqualStringArray( const char** expected,
                                   const char** actual,
                                   const _UU32 num_elements,
@@ -394,10 +830,90 @@ void UnityAssertNumbersWithin(const _U_SINT delta,
                               const UNITY_LINE_TYPE lineNumber,
                               const UNITY_DISPLAY_STYLE_T style);
 
-void UnityFail(const char* message, const UNITY_LINE_TYPE line);
+UNITY_COLD void UnityFail(const char* message, const UNITY_LINE_TYPE line);
 
 void UnityIgnore(const char* message, const UNITY_LINE_TYPE line);
 
+//-------------------------------------------------------
+// Inline Number Assertions
+//-------------------------------------------------------
+//  The number, bits and delta assertions compare inline and
+//  only call into unity.c to report a failure, so a passing
+//  assertion costs little more than the comparison.
+
+UNITY_COLD void UnityFailEqualNumber(const _U_SINT expected,
+                                     const _U_SINT actual,
+                                     const char* msg,
+                                     const UNITY_LINE_TYPE lineNumber,
+                                     const UNITY_DISPLAY_STYLE_T style);
+
+UNITY_COLD void UnityFailBits(const _U_SINT mask,
+                              const _U_SINT expected,
+                              const _U_SINT actual,
+                              const char* msg,
+                              const UNITY_LINE_TYPE lineNumber);
+
+UNITY_COLD void UnityFailNumbersWithin(const _U_SINT delta,
+                                       const _U_SINT expected,
+                                       const _U_SINT actual,
+                                       const char* msg,
+                                       const UNITY_LINE_TYPE lineNumber,
+                                       const UNITY_DISPLAY_STYLE_T style);
+
+#ifdef UNITY_INLINE
+UNITY_INLINE void UnityCheckEqualNumber(const _U_SINT expected,
+                                        const _U_SINT actual,
+                                        const char* msg,
+                                        const UNITY_LINE_TYPE lineNumber,
+                                        const UNITY_DISPLAY_STYLE_T style)
+{
+    if (UNITY_UNLIKELY(expected != actual))
+        UnityFailEqualNumber(expected, actual, msg, lineNumber, style);
+}
+
+UNITY_INLINE void UnityCheckBits(const _U_SINT mask,
+                                 const _U_SINT expected,
+                                 const _U_SINT actual,
+                                 const char* msg,
+                                 const UNITY_LINE_TYPE lineNumber)
+{
+    if (UNITY_UNLIKELY((mask & expected) != (mask & actual)))
+        UnityFailBits(mask, expected, actual, msg, lineNumber);
+}
+
+UNITY_INLINE void UnityCheckNumbersWithin(const _U_SINT delta,
+                                          const _U_SINT expected,
+                                          const _U_SINT actual,
+                                          const char* msg,
+                                          const UNITY_LINE_TYPE lineNumber,
+                                          const UNITY_DISPLAY_STYLE_T style)
+{
+    int outside;
+
+    // the same comparison as UnityAssertNumbersWithin; style is a constant, so only one side remains
+    if ((style & UNITY_DISPLAY_RANGE_INT) == UNITY_DISPLAY_RANGE_INT)
+    {
+        if (actual > expected)
+            outside = ((actual - expected) > delta);
+        else
+            outside = ((expected - actual) > delta);
+    }
+    else
+    {
+        if ((_U_UINT)actual > (_U_UINT)expected)
+            outside = ((_U_UINT)(actual - expected) > (_U_UINT)delta);
+        else
+            outside = ((_U_UINT)(expected - actual) > (_U_UINT)delta);
+    }
+    if (UNITY_UNLIKELY(outside))
+        UnityFailNumbersWithin(delta, expected, actual, msg, lineNumber, style);
+}
+#else
+#define UnityCheckEqualNumber   UnityAssertEqualNumber
+#define UnityCheckBits          UnityAssertBits
+#define UnityCheckNumbersWithin UnityAssertNumbersWithin
+#endif
+
 #ifndef UNITY_EXCLUDE_FLOAT
 void UnityAssertFloatsWithin(const _UF delta,
                              const _UF expected,
@@ -410,6 +926,14 @@ void UnityAssertEqualFloatArray(const _UF* expected,
                                 const _UU32 num_elements,
                                 const char* msg,
                                 const UNITY_LINE_TYPE lineNumber);
+
+void UnityAssertFloatArrayWithin(const _UF tolerance,
+                                 const UNITY_TOLERANCE_T mode,
+                                 const _UF* expected,
+                                 const _UF* actual,
+                                 const _UU32 num_elements,
+                                 const char* msg,
+                                 const UNITY_LINE_TYPE lineNumber);
 #endif
 
 #ifndef UNITY_EXCLUDE_DOUBLE
@@ -424,6 +948,14 @@ void UnityAssertEqualDoubleArray(const _UD* expected,
                                  const _UU32 num_elements,
                                  const char* msg,
                                  const UNITY_LINE_TYPE lineNumber);
+
+void UnityAssertDoubleArrayWithin(const _UD tolerance,
+                                  const UNITY_TOLERANCE_T mode,
+                                  const _UD* expected,
+                                  const _UD* actual,
+                                  const _UU32 num_elements,
+                                  const char* msg,
+                                  const UNITY_LINE_TYPE lineNumber);
 #endif
 
 //-------------------------------------------------------
@@ -437,31 +969,32 @@ void UnityAssertEqualDoubleArray(const _UD* expected,
 // Test Asserts
 //-------------------------------------------------------
 
-#define UNITY_TEST_ASSERT(condition, line, message)                                              if (condition) {} else {UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, message);}
+#define UNITY_TEST_ASSERT(condition, line, message)                                              if (UNITY_LIKELY(condition)) {} else {UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, message);}
 #define UNITY_TEST_ASSERT_NULL(pointer, line, message)                                           UNITY_TEST_ASSERT(((pointer) == NULL),  (UNITY_LINE_TYPE)line, message)
 #define UNITY_TEST_ASSERT_NOT_NULL(pointer, line, message)                                       UNITY_TEST_ASSERT(((pointer) != NULL),  (UNITY_LINE_TYPE)line, message)
 
-#define UNITY_TEST_ASSERT_EQUAL_INT(expected, actual, line, message)                             UnityAssertEqualNumber((_U_SINT)(expected), (_U_SINT)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_INT)
-#define UNITY_TEST_ASSERT_EQUAL_INT8(expected, actual, line, message)                            UnityAssertEqualNumber((_U_SINT)(_US8 )(expected), (_U_SINT)(_US8 )(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_INT)
-#define UNITY_TEST_ASSERT_EQUAL_INT16(expected, actual, line, message)                           UnityAssertEqualNumber((_U_SINT)(_US16)(expected), (_U_SINT)(_US16)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_INT)
-#define UNITY_TEST_ASSERT_EQUAL_INT32(expected, actual, line, message)                           UnityAssertEqualNumber((_U_SINT)(_US32)(expected), (_U_SINT)(_US32)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_INT)
-#define UNITY_TEST_ASSERT_EQUAL_UINT(expected, actual, line, message)                            UnityAssertEqualNumber((_U_SINT)(expected), (_U_SINT)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_UINT)
-#define UNITY_TEST_ASSERT_EQUAL_UINT8(expected, actual, line, message)                           UnityAssertEqualNumber((_U_SINT)(_US8 )(expected), (_U_SINT)(_US8 )(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_UINT)
-#define UNITY_TEST_ASSERT_EQUAL_UINT16(expected, actual, line, message)                          UnityAssertEqualNumber((_U_SINT)(_US16)(expected), (_U_SINT)(_US16)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_UINT)
-#define UNITY_TEST_ASSERT_EQUAL_UINT32(expected, actual, line, message)                          UnityAssertEqualNumber((_U_SINT)(_US32)(expected), (_U_SINT)(_US32)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_UINT)
-#define UNITY_TEST_ASSERT_EQUAL_HEX8(expected, actual, line, message)                            UnityAssertEqualNumber((_U_SINT)(_US8 )(expected), (_U_SINT)(_US8 )(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_HEX8)
-#define UNITY_TEST_ASSERT_EQUAL_HEX16(expected, actual, line, message)                           UnityAssertEqualNumber((_U_SINT)(_US16)(expected), (_U_SINT)(_US16)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_HEX16)
-#define UNITY_TEST_ASSERT_EQUAL_HEX32(expected, actual, line, message)                           UnityAssertEqualNumber((_U_SINT)(_US32)(expected), (_U_SINT)(_US32)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_HEX32)
-#define UNITY_TEST_ASSERT_BITS(mask, expected, actual, line, message)                            UnityAssertBits((_U_SINT)(mask), (_U_SINT)(expected), (_U_SINT)(actual), (message), (UNITY_LINE_TYPE)line)
-
-#define UNITY_TEST_ASSERT_INT_WITHIN(delta, expected, actual, line, message)                     UnityAssertNumbersWithin((_U_SINT)(delta), (_U_SINT)(expected), (_U_SINT)(actual), NULL, (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_INT)
-#define UNITY_TEST_ASSERT_UINT_WITHIN(delta, expected, actual, line, message)                    UnityAssertNumbersWithin((_U_SINT)(delta), (_U_SINT)(expected), (_U_SINT)(actual), NULL, (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_UINT)
-#define UNITY_TEST_ASSERT_HEX8_WITHIN(delta, expected, actual, line, message)                    UnityAssertNumbersWithin((_U_SINT)(_U_UINT)(_UU8 )(delta), (_U_SINT)(_U_UINT)(_UU8 )(expected), (_U_SINT)(_U_UINT)(_UU8 )(actual), NULL, (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_HEX8)
-#define UNITY_TEST_ASSERT_HEX16_WITHIN(delta, expected, actual, line, message)                   UnityAssertNumbersWithin((_U_SINT)(_U_UINT)(_UU16)(delta), (_U_SINT)(_U_UINT)(_UU16)(expected), (_U_SINT)(_U_UINT)(_UU16)(actual), NULL, (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_HEX16)
-#define UNITY_TEST_ASSERT_HEX32_WITHIN(delta, expected, actual, line, message)                   UnityAssertNumbersWithin((_U_SINT)(_U_UINT)(_UU32)(delta), (_U_SINT)(_U_UINT)(_UU32)(expected), (_U_SINT)(_U_UINT)(_UU32)(actual), NULL, (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_HEX32)
-
-#define UNITY_TEST_ASSERT_EQUAL_PTR(expected, actual, line, message)                             UnityAssertEqualNumber((_U_SINT)(_UP)(expected), (_U_SINT)(_UP)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_POINTER)
+#define UNITY_TEST_ASSERT_EQUAL_INT(expected, actual, line, message)                             UnityCheckEqualNumber((_U_SINT)(expected), (_U_SINT)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_INT)
+#define UNITY_TEST_ASSERT_EQUAL_INT8(expected, actual, line, message)                            UnityCheckEqualNumber((_U_SINT)(_US8 )(expected), (_U_SINT)(_US8 )(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_INT)
+#define UNITY_TEST_ASSERT_EQUAL_INT16(expected, actual, line, message)                           UnityCheckEqualNumber((_U_SINT)(_US16)(expected), (_U_SINT)(_US16)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_INT)
+#define UNITY_TEST_ASSERT_EQUAL_INT32(expected, actual, line, message)                           UnityCheckEqualNumber((_U_SINT)(_US32)(expected), (_U_SINT)(_US32)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_INT)
+#define UNITY_TEST_ASSERT_EQUAL_UINT(expected, actual, line, message)                            UnityCheckEqualNumber((_U_SINT)(expected), (_U_SINT)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_UINT)
+#define UNITY_TEST_ASSERT_EQUAL_UINT8(expected, actual, line, message)                           UnityCheckEqualNumber((_U_SINT)(_US8 )(expected), (_U_SINT)(_US8 )(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_UINT)
+#define UNITY_TEST_ASSERT_EQUAL_UINT16(expected, actual, line, message)                          UnityCheckEqualNumber((_U_SINT)(_US16)(expected), (_U_SINT)(_US16)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_UINT)
+#define UNITY_TEST_ASSERT_EQUAL_UINT32(expected, actual, line, message)                          UnityCheckEqualNumber((_U_SINT)(_US32)(expected), (_U_SINT)(_US32)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_UINT)
+#define UNITY_TEST_ASSERT_EQUAL_HEX8(expected, actual, line, message)                            UnityCheckEqualNumber((_U_SINT)(_US8 )(expected), (_U_SINT)(_US8 )(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_HEX8)
+#define UNITY_TEST_ASSERT_EQUAL_HEX16(expected, actual, line, message)                           UnityCheckEqualNumber((_U_SINT)(_US16)(expected), (_U_SINT)(_US16)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_HEX16)
+#define UNITY_TEST_ASSERT_EQUAL_HEX32(expected, actual, line, message)                           UnityCheckEqualNumber((_U_SINT)(_US32)(expected), (_U_SINT)(_US32)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_HEX32)
+#define UNITY_TEST_ASSERT_BITS(mask, expected, actual, line, message)                            UnityCheckBits((_U_SINT)(mask), (_U_SINT)(expected), (_U_SINT)(actual), (message), (UNITY_LINE_TYPE)line)
+
+#define UNITY_TEST_ASSERT_INT_WITHIN(delta, expected, actual, line, message)                     UnityCheckNumbersWithin((_U_SINT)(delta), (_U_SINT)(expected), (_U_SINT)(actual), NULL, (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_INT)
+#define UNITY_TEST_ASSERT_UINT_WITHIN(delta, expected, actual, line, message)                    UnityCheckNumbersWithin((_U_SINT)(delta), (_U_SINT)(expected), (_U_SINT)(actual), NULL, (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_UINT)
+#define UNITY_TEST_ASSERT_HEX8_WITHIN(delta, expected, actual, line, message)                    UnityCheckNumbersWithin((_U_SINT)(_U_UINT)(_UU8 )(delta), (_U_SINT)(_U_UINT)(_UU8 )(expected), (_U_SINT)(_U_UINT)(_UU8 )(actual), NULL, (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_HEX8)
+#define UNITY_TEST_ASSERT_HEX16_WITHIN(delta, expected, actual, line, message)                   UnityCheckNumbersWithin((_U_SINT)(_U_UINT)(_UU16)(delta), (_U_SINT)(_U_UINT)(_UU16)(expected), (_U_SINT)(_U_UINT)(_UU16)(actual), NULL, (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_HEX16)
+#define UNITY_TEST_ASSERT_HEX32_WITHIN(delta, expected, actual, line, message)                   UnityCheckNumbersWithin((_U_SINT)(_U_UINT)(_UU32)(delta), (_U_SINT)(_U_UINT)(_UU32)(expected), (_U_SINT)(_U_UINT)(_UU32)(actual), NULL, (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_HEX32)
+
+#define UNITY_TEST_ASSERT_EQUAL_PTR(expected, actual, line, message)                             UnityCheckEqualNumber((_U_SINT)(_UP)(expected), (_U_SINT)(_UP)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_POINTER)
 #define UNITY_TEST_ASSERT_EQUAL_STRING(expected, actual, line, message)                          UnityAssertEqualString((const char*)(expected), (const char*)(actual), (message), (UNITY_LINE_TYPE)line)
+#define UNITY_TEST_ASSERT_EQUAL_STRING_LEN(expected, actual, len, line, message)                 UnityAssertEqualStringLen((const char*)(expected), (const char*)(actual), (_UU32)(len), (message), (UNITY_LINE_TYPE)line)
 #define UNITY_TEST_ASSERT_EQUAL_MEMORY(expected, actual, len, line, message)                     UnityAssertEqualMemory((void*)(expected), (void*)(actual), (_UU32)(len), 1, (message), (UNITY_LINE_TYPE)line)
 
 #define UNITY_TEST_ASSERT_EQUAL_INT_ARRAY(expected, actual, num_elements, line, message)         UnityAssertEqualIntArray((const _U_SINT*)(expected), (const _U_SINT*)(actual), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_INT)
@@ -480,33 +1013,37 @@ void UnityAssertEqualDoubleArray(const _UD* expected,
 #define UNITY_TEST_ASSERT_EQUAL_MEMORY_ARRAY(expected, actual, len, num_elements, line, message) UnityAssertEqualMemory((void*)(expected), (void*)(actual), (_UU32)(len), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line)
 
 #ifdef UNITY_SUPPORT_64
-#define UNITY_TEST_ASSERT_EQUAL_INT64(expected, actual, line, message)                           UnityAssertEqualNumber((_U_SINT)(expected), (_U_SINT)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_INT64)
-#define UNITY_TEST_ASSERT_EQUAL_UINT64(expected, actual, line, message)                          UnityAssertEqualNumber((_U_SINT)(expected), (_U_SINT)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_UINT64)
-#define UNITY_TEST_ASSERT_EQUAL_HEX64(expected, actual, line, message)                           UnityAssertEqualNumber((_U_SINT)(expected), (_U_SINT)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_HEX64)
+#define UNITY_TEST_ASSERT_EQUAL_INT64(expected, actual, line, message)                           UnityCheckEqualNumber((_U_SINT)(expected), (_U_SINT)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_INT64)
+#define UNITY_TEST_ASSERT_EQUAL_UINT64(expected, actual, line, message)                          UnityCheckEqualNumber((_U_SINT)(expected), (_U_SINT)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_UINT64)
+#define UNITY_TEST_ASSERT_EQUAL_HEX64(expected, actual, line, message)                           UnityCheckEqualNumber((_U_SINT)(expected), (_U_SINT)(actual), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_HEX64)
 #define UNITY_TEST_ASSERT_EQUAL_INT64_ARRAY(expected, actual, num_elements, line, message)       UnityAssertEqualIntArray((const _U_SINT*)(expected), (const _U_SINT*)(actual), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_INT64)
 #define UNITY_TEST_ASSERT_EQUAL_UINT64_ARRAY(expected, actual, num_elements, line, message)      UnityAssertEqualIntArray((const _U_SINT*)(expected), (const _U_SINT*)(actual), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_UINT64)
 #define UNITY_TEST_ASSERT_EQUAL_HEX64_ARRAY(expected, actual, num_elements, line, message)       UnityAssertEqualIntArray((const _U_SINT*)(expected), (const _U_SINT*)(actual), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_HEX64)
-#define UNITY_TEST_ASSERT_HEX64_WITHIN(delta, expected, actual, line, message)                   UnityAssertNumbersWithin((_U_SINT)(delta), (_U_SINT)(expected), (_U_SINT)(actual), NULL, (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_HEX64)
+#define UNITY_TEST_ASSERT_HEX64_WITHIN(delta, expected, actual, line, message)                   UnityCheckNumbersWithin((_U_SINT)(delta), (_U_SINT)(expected), (_U_SINT)(actual), NULL, (UNITY_LINE_TYPE)line, UNITY_DISPLAY_STYLE_HEX64)
 #endif
 
 #ifdef UNITY_EXCLUDE_FLOAT
 #define UNITY_TEST_ASSERT_FLOAT_WITHIN(delta, expected, actual, line, message)                   UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, "Unity Floating Point Disabled")
 #define UNITY_TEST_ASSERT_EQUAL_FLOAT(expected, actual, line, message)                           UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, "Unity Floating Point Disabled")
 #define UNITY_TEST_ASSERT_EQUAL_FLOAT_ARRAY(expected, actual, num_elements, line, message)       UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, "Unity Floating Point Disabled")
+#define UNITY_TEST_ASSERT_FLOAT_ARRAY_WITHIN(tolerance, mode, expected, actual, num_elements, line, message) UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, "Unity Floating Point Disabled")
 #else
 #define UNITY_TEST_ASSERT_FLOAT_WITHIN(delta, expected, actual, line, message)                   UnityAssertFloatsWithin((_UF)(delta), (_UF)(expected), (_UF)(actual), (message), (UNITY_LINE_TYPE)line)
 #define UNITY_TEST_ASSERT_EQUAL_FLOAT(expected, actual, line, message)                           UNITY_TEST_ASSERT_FLOAT_WITHIN((_UF)(expected) * (_UF)UNITY_FLOAT_PRECISION, (_UF)expected, (_UF)actual, (UNITY_LINE_TYPE)line, message)
 #define UNITY_TEST_ASSERT_EQUAL_FLOAT_ARRAY(expected, actual, num_elements, line, message)       UnityAssertEqualFloatArray((_UF*)(expected), (_UF*)(actual), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line)
+#define UNITY_TEST_ASSERT_FLOAT_ARRAY_WITHIN(tolerance, mode, expected, actual, num_elements, line, message) UnityAssertFloatArrayWithin((_UF)(tolerance), (mode), (_UF*)(expected), (_UF*)(actual), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line)
 #endif
 
 #ifdef UNITY_EXCLUDE_DOUBLE
 #define UNITY_TEST_ASSERT_DOUBLE_WITHIN(delta, expected, actual, line, message)                  UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, "Unity Double Precision Disabled")
 #define UNITY_TEST_ASSERT_EQUAL_DOUBLE(expected, actual, line, message)                          UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, "Unity Double Precision Disabled")
 #define UNITY_TEST_ASSERT_EQUAL_DOUBLE_ARRAY(expected, actual, num_elements, line, message)      UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, "Unity Double Precision Disabled")
+#define UNITY_TEST_ASSERT_DOUBLE_ARRAY_WITHIN(tolerance, mode, expected, actual, num_elements, line, message) UNITY_TEST_FAIL((UNITY_LINE_TYPE)line, "Unity Double Precision Disabled")
 #else
 #define UNITY_TEST_ASSERT_DOUBLE_WITHIN(delta, expected, actual, line, message)                  UnityAssertDoublesWithin((_UD)(delta), (_UD)(expected), (_UD)(actual), (message), (UNITY_LINE_TYPE)line)
 #define UNITY_TEST_ASSERT_EQUAL_DOUBLE(expected, actual, line, message)                          UNITY_TEST_ASSERT_DOUBLE_WITHIN((_UF)(expected) * (_UD)UNITY_DOUBLE_PRECISION, (_UD)expected, (_UD)actual, (UNITY_LINE_TYPE)line, message)
 #define UNITY_TEST_ASSERT_EQUAL_DOUBLE_ARRAY(expected, actual, num_elements, line, message)      UnityAssertEqualDoubleArray((_UD*)(expected), (_UD*)(actual), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line)
+#define UNITY_TEST_ASSERT_DOUBLE_ARRAY_WITHIN(tolerance, mode, expected, actual, num_elements, line, message) UnityAssertDoubleArrayWithin((_UD)(tolerance), (mode), (_UD*)(expected), (_UD*)(actual), (_UU32)(num_elements), (message), (UNITY_LINE_TYPE)line)
 #endif
 
 #endif
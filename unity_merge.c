@@ -0,0 +1,186 @@
+/* ==========================================
+    Unity Project - A Test Framework for C
+    Copyright (c) 2007 Mike Karlesky, Mark VanderVoord, Greg Williams
+    [Released under MIT License. Please refer to license.txt for details]
+========================================== */
+
+// Adds up the results of a sharded run into the summary UnityEnd() would have
+// printed had every test run in one process.  Build it on the host with the
+// options the tests were built with:
+//
+//     cc -o unity_merge unity_merge.c unity.c
+//     unity_merge shard0.txt shard1.txt ...
+//     unity_merge test_file.c.json ...
+//
+// Each input is either a shard's console output, whose last summary line is
+// used, or its JSON report (.json, or .jsonl with UNITY_REPORT_JSON_LINES),
+// whose records are counted.  A console log without a summary means the shard
+// never reached UnityEnd(), and counts as a failure.  The exit status is the
+// number of failures, like UnityEnd(), or 255 if an input cannot be read.
+
+#include "unity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// unity.c calls these around every test it runs; the merge runs none
+void setUp(void) {}
+void tearDown(void) {}
+
+struct _UnityTotals
+{
+    unsigned long Tests;
+    unsigned long Failures;
+    unsigned long Ignores;
+};
+
+//-----------------------------------------------
+static char* UnityReadFile(const char* path)
+{
+    char* text = NULL;
+    size_t capacity = 0;
+    size_t size = 0;
+    size_t got;
+    FILE* file = fopen(path, "rb");
+
+    if (file == NULL)
+        return NULL;
+    do
+    {
+        if (capacity - size < 2)
+        {
+            char* grown;
+            capacity = (capacity == 0) ? 65536 : capacity * 2;
+            grown = (char*)realloc(text, capacity);
+            if (grown == NULL)
+            {
+                free(text);
+                fclose(file);
+                return NULL;
+            }
+            text = grown;
+        }
+        got = fread(&text[size], 1, capacity - size - 1, file);
+        size += got;
+    } while (got > 0);
+    fclose(file);
+    text[size] = '\0';
+    return text;
+}
+
+//-----------------------------------------------
+/// the last "N Tests N Failures N Ignored" line of a console log; 0 if there is none
+static int UnityConsoleTotals(const char* text, struct _UnityTotals* totals)
+{
+    const char* line = text;
+    const char* next;
+    char copy[96];
+    size_t length;
+    int found = 0;
+
+    while (line != NULL)
+    {
+        struct _UnityTotals seen;
+        int used = 0;
+
+        next = strchr(line, '\n');
+        length = (next != NULL) ? (size_t)(next - line) : strlen(line);
+        if ((length > 0) && (line[length - 1] == '\r'))
+            length--;
+        // a summary line is short, and sscanf is only given the one line
+        if ((length < sizeof(copy)) && (*line >= '0') && (*line <= '9'))
+        {
+            memcpy(copy, line, length);
+            copy[length] = '\0';
+            if ((sscanf(copy, "%lu Tests %lu Failures %lu Ignored%n", &seen.Tests, &seen.Failures, &seen.Ignores, &used) == 3) &&
+                ((size_t)used == length))
+            {
+                *totals = seen;
+                found = 1;
+            }
+        }
+        line = (next != NULL) ? next + 1 : NULL;
+    }
+    return found;
+}
+
+//-----------------------------------------------
+static unsigned long UnityCount(const char* text, const char* key)
+{
+    unsigned long count = 0;
+
+    // values are escaped, so a key can only appear as a key
+    while ((text = strstr(text, key)) != NULL)
+    {
+        count++;
+        text += strlen(key);
+    }
+    return count;
+}
+
+/// count the records of a JSON report, in either layout
+static void UnityReportTotals(const char* text, struct _UnityTotals* totals)
+{
+    const unsigned long passes = UnityCount(text, "\"result\":\"PASS\"") + UnityCount(text, "\"status\":\"PASS\"");
+    const unsigned long failures = UnityCount(text, "\"result\":\"Fail\"") + UnityCount(text, "\"status\":\"FAIL\"") +
+                                   UnityCount(text, "\"result\":\"Timeout\"") + UnityCount(text, "\"status\":\"TIMEOUT\"");
+    const unsigned long ignores = UnityCount(text, "\"IGNORE\":\"") - UnityCount(text, "\"IGNORE\":\"NOT IGNORED\"") +
+                                  UnityCount(text, "\"status\":\"IGNORE\"");
+
+    totals->Tests = passes + failures + ignores;
+    // like UnityEnd, a benchmark that regressed against its baseline is a failure too
+    totals->Failures = failures + UnityCount(text, "\"baseline\":\"REGRESSED\"");
+    totals->Ignores = ignores;
+}
+
+//-----------------------------------------------
+static int UnityIsReport(const char* path)
+{
+    const char* extension = strrchr(path, '.');
+
+    return (extension != NULL) && ((strcmp(extension, ".json") == 0) || (strcmp(extension, ".jsonl") == 0));
+}
+
+//-----------------------------------------------
+int main(int argc, char** argv)
+{
+    struct _UnityTotals sum = { 0, 0, 0 };
+    int i;
+
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <shard console log or JSON report>...\n", argv[0]);
+        return 255;
+    }
+
+    for (i = 1; i < argc; i++)
+    {
+        struct _UnityTotals totals = { 0, 0, 0 };
+        char* text = UnityReadFile(argv[i]);
+
+        if (text == NULL)
+        {
+            fprintf(stderr, "%s: cannot read %s\n", argv[0], argv[i]);
+            return 255;
+        }
+        if (UnityIsReport(argv[i]))
+        {
+            UnityReportTotals(text, &totals);
+        }
+        else if (!UnityConsoleTotals(text, &totals))
+        {
+            fprintf(stderr, "%s: %s has no summary, so that shard did not finish\n", argv[0], argv[i]);
+            totals.Failures = 1;
+        }
+        free(text);
+
+        sum.Tests += totals.Tests;
+        sum.Failures += totals.Failures;
+        sum.Ignores += totals.Ignores;
+    }
+
+    Unity.NumberOfTests = (UNITY_COUNTER_TYPE)sum.Tests;
+    Unity.TestFailures = (UNITY_COUNTER_TYPE)sum.Failures;
+    Unity.TestIgnores = (UNITY_COUNTER_TYPE)sum.Ignores;
+    return UnityEnd();
+}